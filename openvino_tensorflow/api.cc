@@ -8,11 +8,19 @@
 #include <dirent.h>
 #endif
 #include <sys/stat.h>
+#include <algorithm>
+#include <cctype>
+#include <mutex>
 
 #include "tensorflow/core/lib/core/errors.h"
 
 #include "api.h"
 #include "backend_manager.h"
+#include "compile_scheduler.h"
+#include "executable_cache.h"
+#include "execution_counters.h"
+#include "model_cache.h"
+#include "warmup.h"
 
 namespace tensorflow {
 namespace openvino_tensorflow {
@@ -25,6 +33,8 @@ static char* backendName = nullptr;
 static char* backendList[4];
 static char* clusterInfo = nullptr;
 static char* errMsg = nullptr;
+static std::mutex compile_properties_mutex;
+static CompileProperties compile_properties{};
 
 extern "C" {
 void enable() { Enable(); }
@@ -113,6 +123,70 @@ bool export_ir(const char* output_dir, char** cluster_info, char** err_msg) {
   *cluster_info = clusterInfo;
   return true;
 }
+
+void set_model_cache_dir(const char* cache_dir) {
+  SetModelCacheDir(string(cache_dir));
+}
+
+void set_executable_cache_limit(int64_t limit_mb) {
+  SetExecutableCacheLimit(limit_mb);
+}
+
+void get_executable_cache_stats(int64_t* stats) {
+  ExecutableCacheStats cache_stats = GetExecutableCacheStats();
+  int64_t values[kExecutableCacheStatsLen] = {
+      cache_stats.num_entries, cache_stats.size_bytes,
+      cache_stats.limit_bytes, cache_stats.hits,
+      cache_stats.misses,      cache_stats.insertions,
+      cache_stats.evictions,   cache_stats.evicted_bytes};
+  for (int i = 0; i < kExecutableCacheStatsLen; i++) stats[i] = values[i];
+}
+
+void get_execution_stats(int64_t* stats) {
+  ExecutionStats execution_stats = GetExecutionStats();
+  int64_t values[kExecutionStatsLen] = {
+      execution_stats.template_reshapes, execution_stats.split_inferences,
+      execution_stats.micro_batches, execution_stats.micro_batched_calls,
+      execution_stats.lean_executables};
+  for (int i = 0; i < kExecutionStatsLen; i++) stats[i] = values[i];
+}
+
+bool warmup(int num_inputs, const char** input_names, int num_signatures,
+            const int* ranks, const int64_t* dims) {
+  if (num_inputs < 0 || num_signatures < 0) return false;
+  vector<WarmupSignature> signatures(num_signatures);
+  for (int k = 0; k < num_signatures; k++) {
+    for (int i = 0; i < num_inputs; i++) {
+      int rank = ranks[k * num_inputs + i];
+      if (rank < 0) return false;
+      vector<int64_t> shape(dims, dims + rank);
+      for (auto dim : shape) {
+        if (dim < 0) return false;
+      }
+      signatures[k][string(input_names[i])] = shape;
+      dims += rank;
+    }
+  }
+  Warmup(signatures);
+  return true;
+}
+
+bool is_warmup_complete() { return IsWarmupComplete(); }
+
+bool wait_for_warmup(int64_t timeout_ms) { return WaitForWarmup(timeout_ms); }
+
+void get_compile_progress(int64_t* progress) {
+  CompileProgress compile_progress = GetCompileProgress();
+  int64_t values[kCompileProgressLen] = {
+      compile_progress.queued, compile_progress.running,
+      compile_progress.completed, compile_progress.failed,
+      compile_progress.dropped};
+  for (int i = 0; i < kCompileProgressLen; i++) progress[i] = values[i];
+}
+
+bool set_compile_property(const char* name, const char* value) {
+  return SetCompileProperty(string(name), string(value));
+}
 }
 
 // note that TensorFlow always uses camel case for the C++ API, but not for
@@ -192,6 +266,93 @@ bool ExportIR(const string& output_dir, string& cluster_info, string& err_msg) {
   return true;
 }
 
+void SetModelCacheDir(const string& cache_dir) {
+  ModelCache::SetCacheDir(cache_dir);
+}
+
+string GetModelCacheDir() { return ModelCache::GetCacheDir(); }
+
+void SetExecutableCacheLimit(int64_t limit_mb) {
+  ExecutableCache::SetLimit(limit_mb * 1024 * 1024);
+}
+
+ExecutableCacheStats GetExecutableCacheStats() {
+  auto stats = ExecutableCache::GetStats();
+  return ExecutableCacheStats{stats.num_entries, stats.size_bytes,
+                              stats.limit_bytes, stats.hits,
+                              stats.misses,      stats.insertions,
+                              stats.evictions,   stats.evicted_bytes};
+}
+
+ExecutionStats GetExecutionStats() {
+  return ExecutionStats{
+      ExecutionCounters::Get(ExecutionCounters::kTemplateReshapes),
+      ExecutionCounters::Get(ExecutionCounters::kSplitInferences),
+      ExecutionCounters::Get(ExecutionCounters::kMicroBatches),
+      ExecutionCounters::Get(ExecutionCounters::kMicroBatchedCalls),
+      ExecutionCounters::Get(ExecutionCounters::kLeanExecutables)};
+}
+
+void Warmup(const vector<WarmupSignature>& signatures) {
+  vector<WarmupRegistry::Signature> registry_signatures;
+  for (const auto& signature : signatures) {
+    WarmupRegistry::Signature registry_signature;
+    for (const auto& input : signature) {
+      TensorShape shape;
+      for (auto dim : input.second) shape.AddDim(dim);
+      registry_signature[input.first] = shape;
+    }
+    registry_signatures.push_back(registry_signature);
+  }
+  WarmupRegistry::SetSignatures(registry_signatures);
+}
+
+bool IsWarmupComplete() { return WarmupRegistry::IsComplete(); }
+
+bool WaitForWarmup(int64_t timeout_ms) {
+  return WarmupRegistry::Wait(timeout_ms);
+}
+
+CompileProgress GetCompileProgress() {
+  auto progress = CompileScheduler::Get().GetProgress();
+  return CompileProgress{progress.queued, progress.running, progress.completed,
+                         progress.failed, progress.dropped};
+}
+
+const vector<string> kCompilePropertyNames = {
+    "performance_mode", "num_streams", "inference_num_threads",
+    "enable_cpu_pinning", "inference_precision"};
+
+bool SetCompileProperty(const string& name, const string& value) {
+  if (std::find(kCompilePropertyNames.begin(), kCompilePropertyNames.end(),
+                name) == kCompilePropertyNames.end()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(compile_properties_mutex);
+  if (value.empty()) {
+    compile_properties.erase(name);
+  } else {
+    compile_properties[name] = value;
+  }
+  return true;
+}
+
+CompileProperties GetCompileProperties() {
+  CompileProperties properties;
+  for (const auto& name : kCompilePropertyNames) {
+    string env_name = "OPENVINO_TF_" + name;
+    std::transform(env_name.begin(), env_name.end(), env_name.begin(),
+                   ::toupper);
+    const char* value = std::getenv(env_name.c_str());
+    if (value != nullptr && *value != '\0') properties[name] = value;
+  }
+  std::lock_guard<std::mutex> lock(compile_properties_mutex);
+  for (const auto& property : compile_properties) {
+    properties[property.first] = property.second;
+  }
+  return properties;
+}
+
 }  // namespace api
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
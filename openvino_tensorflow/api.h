@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
@@ -51,6 +53,33 @@ extern EXPORT_SYMBOL void disable_dynamic_fallback();
 
 extern EXPORT_SYMBOL bool export_ir(const char* output_dir, char** cluster_info,
                                     char** err_msg);
+
+extern EXPORT_SYMBOL void set_model_cache_dir(const char* cache_dir);
+
+extern EXPORT_SYMBOL void set_executable_cache_limit(int64_t limit_mb);
+// Fills the kExecutableCacheStatsLen values of ExecutableCacheStats, in
+// declaration order
+extern EXPORT_SYMBOL void get_executable_cache_stats(int64_t* stats);
+// Fills the kExecutionStatsLen values of ExecutionStats, in declaration order
+extern EXPORT_SYMBOL void get_execution_stats(int64_t* stats);
+
+// Declares num_signatures sets of shapes of the num_inputs graph inputs.
+// ranks holds the rank of every input of the first signature, then of the
+// second one and so on, and dims holds all their dims in the same order.
+extern EXPORT_SYMBOL bool warmup(int num_inputs, const char** input_names,
+                                 int num_signatures, const int* ranks,
+                                 const int64_t* dims);
+extern EXPORT_SYMBOL bool is_warmup_complete();
+extern EXPORT_SYMBOL bool wait_for_warmup(int64_t timeout_ms);
+
+// Fills the kCompileProgressLen values of CompileProgress, in declaration
+// order
+extern EXPORT_SYMBOL void get_compile_progress(int64_t* progress);
+
+// Sets one of the kCompilePropertyNames, an empty value reverts to the
+// environment. Returns false for unknown names.
+extern EXPORT_SYMBOL bool set_compile_property(const char* name,
+                                               const char* value);
 }
 
 extern void Enable();
@@ -75,6 +104,76 @@ extern void DisableDynamicFallback();
 
 extern bool ExportIR(const string& output_dir, string& cluster_info,
                      string& err_msg);
+
+extern void SetModelCacheDir(const string& cache_dir);
+extern string GetModelCacheDir();
+
+// Occupancy and eviction statistics of the process-wide executable cache
+struct ExecutableCacheStats {
+  int64_t num_entries;
+  int64_t size_bytes;
+  int64_t limit_bytes;
+  int64_t hits;
+  int64_t misses;
+  int64_t insertions;
+  int64_t evictions;
+  int64_t evicted_bytes;
+};
+constexpr int kExecutableCacheStatsLen = 8;
+
+// Sets the size limit of the executable cache in MB, 0 for no limit
+extern void SetExecutableCacheLimit(int64_t limit_mb);
+extern ExecutableCacheStats GetExecutableCacheStats();
+
+// Counts of the optional execution paths taken by all clusters
+struct ExecutionStats {
+  int64_t template_reshapes;
+  int64_t split_inferences;
+  int64_t micro_batches;
+  int64_t micro_batched_calls;
+  int64_t lean_executables;
+};
+constexpr int kExecutionStatsLen = 5;
+
+extern ExecutionStats GetExecutionStats();
+
+// Shapes of graph inputs, by the name of the fed tensor or function argument
+using WarmupSignature = std::map<string, vector<int64_t>>;
+
+// Compiles the clusters of the graphs rewritten from now on for the input
+// shapes of each signature, in the background and before their first run
+extern void Warmup(const vector<WarmupSignature>& signatures);
+// True once the clusters have been compiled for the declared signatures
+extern bool IsWarmupComplete();
+// Waits up to timeout_ms, forever if negative, for the warmup to complete.
+// Returns false right away while no graph has been rewritten since the
+// signatures were declared.
+extern bool WaitForWarmup(int64_t timeout_ms);
+
+// Counts of the background and ahead-of-time compilations
+struct CompileProgress {
+  int64_t queued;
+  int64_t running;
+  int64_t completed;
+  int64_t failed;
+  int64_t dropped;
+};
+constexpr int kCompileProgressLen = 5;
+
+extern CompileProgress GetCompileProgress();
+
+// OpenVINO properties applied when the clusters are compiled, by name
+using CompileProperties = std::map<string, string>;
+// performance_mode, num_streams, inference_num_threads, enable_cpu_pinning
+// and inference_precision
+extern const vector<string> kCompilePropertyNames;
+
+// Sets a property for the compilations started from now on, overriding the
+// OPENVINO_TF_<NAME> environment variable. An empty value reverts to the
+// environment variable.
+extern bool SetCompileProperty(const string& name, const string& value);
+// The properties set through the environment or SetCompileProperty
+extern CompileProperties GetCompileProperties();
 }  // namespace api
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
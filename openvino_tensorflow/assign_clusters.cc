@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 #include <algorithm>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "tensorflow/core/framework/attr_value_util.h"
 #include "tensorflow/core/framework/graph.pb.h"
@@ -81,45 +84,54 @@ namespace openvino_tensorflow {
 namespace {
 struct Cluster {
   int index;
-  std::set<tensorflow::Node*> nodes;
-  std::string predicate_string;
+  std::vector<tensorflow::Node*> nodes;
+  // Handle of the deadness analysis
+  DeadnessAnalysis::PredicateHandle predicate;
   std::set<const Edge*> outgoing_edges;
 };
 
+// Clusters by node id
+using ClusterMap = std::vector<std::shared_ptr<Cluster>>;
+
 // Returns the predicate of the merged cluster
 // If Src Predicate is TRUE then merged cluster gets the dst predicate
 // WARNING : This function does not do any checks
 // Use this function when ready to merge
-inline string GetMergedClusterPred(const string& src_predicate,
-                                   const string& dst_predicate) {
-  return DeadnessAnalysis::IsTruePredString(src_predicate) ? dst_predicate
-                                                           : src_predicate;
+inline DeadnessAnalysis::PredicateHandle GetMergedClusterPred(
+    const DeadnessAnalysis& deadness,
+    DeadnessAnalysis::PredicateHandle src_predicate,
+    DeadnessAnalysis::PredicateHandle dst_predicate) {
+  return deadness.IsTruePredicate(src_predicate) ? dst_predicate
+                                                 : src_predicate;
 }
 
 // Checks whether it's ok to contract the edge as far as deadness is concerned
 // Source and Dst Predicates of the edge should match
-Status CanContractEdgeDeadnessCheck(
-    Edge* edge, const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map,
-    bool& is_deadness_ok) {
+Status CanContractEdgeDeadnessCheck(const Edge* edge,
+                                    const ClusterMap& cluster_map,
+                                    const DeadnessAnalysis& deadness,
+                                    bool& is_deadness_ok) {
   Node* src = edge->src();
   Node* dst = edge->dst();
 
-  string src_predicate = cluster_map.at(src)->predicate_string;
-  string dst_predicate = cluster_map.at(dst)->predicate_string;
+  DeadnessAnalysis::PredicateHandle src_predicate =
+      cluster_map[src->id()]->predicate;
+  DeadnessAnalysis::PredicateHandle dst_predicate =
+      cluster_map[dst->id()]->predicate;
+  bool src_is_true = deadness.IsTruePredicate(src_predicate);
+  bool dst_is_true = deadness.IsTruePredicate(dst_predicate);
 
   // If the node marked for clustering has CONTROL_FLOW_PRED_STRING, it
   // breaks our assumption that all supported ops are data flow ops
-  if (DeadnessAnalysis::IsControlFlowPredString(src_predicate) ||
-      DeadnessAnalysis::IsControlFlowPredString(dst_predicate)) {
+  if (DeadnessAnalysis::IsControlFlowPredicate(src_predicate) ||
+      DeadnessAnalysis::IsControlFlowPredicate(dst_predicate)) {
     return errors::Internal(
         "Attempting to contract edge with control flow ops : ",
         edge->DebugString());
   }
 
   // Case src X , dst Y , X!=Y // cannot be contracted
-  if (!DeadnessAnalysis::IsTruePredString(src_predicate) &&
-      !DeadnessAnalysis::IsTruePredString(dst_predicate) &&
-      src_predicate != dst_predicate) {
+  if (!src_is_true && !dst_is_true && src_predicate != dst_predicate) {
     is_deadness_ok = false;
     return Status::OK();
   }
@@ -127,8 +139,7 @@ Status CanContractEdgeDeadnessCheck(
   // Case src X , dst True // invalid scenario
   // If src has Non-True Predicate and dst has True Predicate, it implies that
   // the dst node is control flow
-  if (!DeadnessAnalysis::IsTruePredString(src_predicate) &&
-      DeadnessAnalysis::IsTruePredString(dst_predicate)) {
+  if (!src_is_true && dst_is_true) {
     return errors::Internal("Attempting to cluster control-flow node ",
                             dst->name(), "[", dst->type_string(), "]");
   }
@@ -138,33 +149,23 @@ Status CanContractEdgeDeadnessCheck(
   // have the predicate Y (True & Y = Y). Hence contraction is possible only
   // when, all outputs of the src cluster (other than the current edge) have the
   // predicate Y
-  if (DeadnessAnalysis::IsTruePredString(src_predicate)) {
-    auto src_cluster_out_edges = cluster_map.at(src)->outgoing_edges;
-    bool found_same_out_preds = true;
-    std::string pred_check = dst_predicate;
-
-    for (const Edge* src_cluster_edge : src_cluster_out_edges) {
+  // Note that if dst predicate is True, then it does not matter what the
+  // predicates of the other outputs are; After merge the merged cluster will
+  // always have a less strict predicate, True (since True is the least strict
+  // predicate)
+  if (src_is_true && !dst_is_true) {
+    for (const Edge* src_cluster_edge :
+         cluster_map[src->id()]->outgoing_edges) {
       if (src_cluster_edge == edge) {
         continue;
       }
       Node* src_cluster_dst = src_cluster_edge->dst();
-      std::string src_cluster_dst_pred =
-          cluster_map.at(src_cluster_dst)->predicate_string;
-      // Note that if dst predicate is True, then it does not matter what the
-      // src_cluster_dst_pred is; After merge the merged cluster will always
-      // have a less strict predicate, True (since True is the least strict
-      // predicate)
-      if (!DeadnessAnalysis::IsTruePredString(pred_check) &&
-          pred_check != src_cluster_dst_pred) {
-        found_same_out_preds = false;
-        break;
+      // Cannot contract this edge
+      if (cluster_map[src_cluster_dst->id()]->predicate != dst_predicate) {
+        is_deadness_ok = false;
+        return Status::OK();
       }
     }
-    // Cannot contract this edge
-    if (!found_same_out_preds) {
-      is_deadness_ok = false;
-      return Status::OK();
-    }
   }
 
   // Case src X, dst Y, X==Y
@@ -177,52 +178,47 @@ Status CanContractEdgeDeadnessCheck(
 
 // Some sanity checks for Node's cluster assignment wrt Deadness
 Status CheckNodeClusterAssignmentWRTDeadness(
-    Node* node, const std::map<Node*, string>& nodes_predicate_map,
-    const std::map<Node*, std::shared_ptr<Cluster>>& cluster_map) {
-  auto itr = nodes_predicate_map.find(node);
-  if (itr == nodes_predicate_map.end()) {
-    return errors::Internal("Node ", node->name(), " [", node->type_string(),
-                            "]", " not found in predicate map");
-  }
-  std::string node_pred_string = itr->second;
+    Node* node,
+    const std::vector<DeadnessAnalysis::PredicateHandle>& node_predicates,
+    const ClusterMap& cluster_map, const DeadnessAnalysis& deadness) {
+  DeadnessAnalysis::PredicateHandle node_pred = node_predicates[node->id()];
 
-  if (DeadnessAnalysis::IsControlFlowPredString(node_pred_string)) {
+  if (DeadnessAnalysis::IsControlFlowPredicate(node_pred)) {
     return errors::Internal(
         "Node ", node->name(), " [", node->type_string(), "]",
         " should not be clustered as it is a control flow op");
   }
 
-  std::string cluster_pred_string = cluster_map.at(node)->predicate_string;
-  int node_cluster_index = cluster_map.at(node)->index;
+  DeadnessAnalysis::PredicateHandle cluster_pred =
+      cluster_map[node->id()]->predicate;
+  int node_cluster_index = cluster_map[node->id()]->index;
 
   // If the node has Non-True Pred (P1) it can only be placed in a cluster with
   // the same pred
-  if (!DeadnessAnalysis::IsTruePredString(node_pred_string) &&
-      node_pred_string != cluster_pred_string) {
+  if (!deadness.IsTruePredicate(node_pred) && node_pred != cluster_pred) {
     return errors::Internal(
         "Node ", node->name(), " [", node->type_string(), "]", " Predicate : ",
-        node_pred_string, "should not be clustered in cluster with predicate ",
-        cluster_pred_string);
+        deadness.PredicateString(node_pred),
+        "should not be clustered in cluster with predicate ",
+        deadness.PredicateString(cluster_pred));
   }
 
   // If the node has True Pred (T1) and its cluster pred is non-true (P1)
   // Then all outgoing edges from node which are not in the same cluster should
   // be connected to clusters with pred P1
-  if (DeadnessAnalysis::IsTruePredString(node_pred_string) &&
-      !DeadnessAnalysis::IsTruePredString(cluster_pred_string)) {
+  if (deadness.IsTruePredicate(node_pred) &&
+      !deadness.IsTruePredicate(cluster_pred)) {
     for (auto e : node->out_edges()) {
-      Node* e_dst = e->dst();
-      if (cluster_map.at(e_dst)->index != node_cluster_index) {
-        string e_dst_cluster_pred = cluster_map.at(e_dst)->predicate_string;
-        if (e_dst_cluster_pred != cluster_pred_string) {
-          return errors::Internal(
-              "Node ", node->name(), " [", node->type_string(), "]",
-              " Predicate : ", node_pred_string,
-              " cannot not be clustered in cluster with predicate ",
-              cluster_pred_string,
-              " as it has outgoing edge to a cluster with predicate ",
-              e_dst_cluster_pred);
-        }
+      const auto& e_dst_cluster = cluster_map[e->dst()->id()];
+      if (e_dst_cluster->index != node_cluster_index &&
+          e_dst_cluster->predicate != cluster_pred) {
+        return errors::Internal(
+            "Node ", node->name(), " [", node->type_string(), "]",
+            " Predicate : ", deadness.PredicateString(node_pred),
+            " cannot not be clustered in cluster with predicate ",
+            deadness.PredicateString(cluster_pred),
+            " as it has outgoing edge to a cluster with predicate ",
+            deadness.PredicateString(e_dst_cluster->predicate));
       }
     }
   }
@@ -232,43 +228,48 @@ Status CheckNodeClusterAssignmentWRTDeadness(
 
 // Merges src and dst clusters of the edge
 // This function does not do any checks for merging, but rather implements the
-// merge, i.e. updates the properties of the merged cluster
+// merge, i.e. updates the properties of the merged cluster. The cluster with
+// fewer nodes is merged into the other one, which takes merged_index, the
+// node that the contraction kept in the GraphCycles. Returns the cluster that
+// was merged away.
 // WARNING : Use this function when ready to merge
-void MergeClusters(Edge* edge,
-                   std::map<Node*, std::shared_ptr<Cluster>>& cluster_map) {
+std::shared_ptr<Cluster> MergeClusters(const Edge* edge, int merged_index,
+                                       ClusterMap& cluster_map,
+                                       const DeadnessAnalysis& deadness) {
   Node* src = edge->src();
   Node* dst = edge->dst();
-  int src_index = cluster_map[src]->index;
-  int dst_index = cluster_map[dst]->index;
+  auto src_cluster = cluster_map[src->id()];
+  auto dst_cluster = cluster_map[dst->id()];
 
-  // Merge dst cluster into src cluster
   OVTF_VLOG(5) << "Contracting: " << src->name() << "[" << src->type_string()
-               << " , " << edge->src_output() << "]@" << src_index << " -> "
-               << dst->name() << "[" << dst->type_string() << " , "
-               << edge->dst_input() << "]@" << dst_index;
-
-  string src_predicate = cluster_map[src]->predicate_string;
-  string dst_predicate = cluster_map[dst]->predicate_string;
-  OVTF_VLOG(5) << "Src pred: " << src_predicate
-               << ", Dst pred: " << dst_predicate;
-
-  std::string cluster_pred = GetMergedClusterPred(src_predicate, dst_predicate);
-
-  cluster_map[src]->predicate_string = cluster_pred;
+               << " , " << edge->src_output() << "]@" << src_cluster->index
+               << " -> " << dst->name() << "[" << dst->type_string() << " , "
+               << edge->dst_input() << "]@" << dst_cluster->index;
+  OVTF_VLOG(5) << "Src pred: "
+               << deadness.PredicateString(src_cluster->predicate)
+               << ", Dst pred: "
+               << deadness.PredicateString(dst_cluster->predicate);
+
+  auto cluster_pred = GetMergedClusterPred(deadness, src_cluster->predicate,
+                                           dst_cluster->predicate);
+
+  auto merged = src_cluster;
+  auto removed = dst_cluster;
+  if (removed->nodes.size() > merged->nodes.size()) {
+    std::swap(merged, removed);
+  }
+  merged->index = merged_index;
+  merged->predicate = cluster_pred;
   // Update outgoing edges of the merged cluster
-  cluster_map[src]->outgoing_edges.insert(
-      cluster_map[dst]->outgoing_edges.begin(),
-      cluster_map[dst]->outgoing_edges.end());
-  cluster_map[src]->outgoing_edges.erase(edge);
-
-  auto cluster_dst = cluster_map[dst];
-  // using cluster_map[dst]->nodes in the loop directly appears to
-  // invalidate the iterator when `node` == `dst`
-  // this happens with clang but not gcc
-  for (auto node : cluster_dst->nodes) {
-    cluster_map[src]->nodes.insert(node);
-    cluster_map[node] = cluster_map[src];
+  merged->outgoing_edges.insert(removed->outgoing_edges.begin(),
+                                removed->outgoing_edges.end());
+  merged->outgoing_edges.erase(edge);
+
+  for (auto node : removed->nodes) {
+    merged->nodes.push_back(node);
+    cluster_map[node->id()] = merged;
   }
+  return removed;
 }
 
 }  // namespace
@@ -277,34 +278,38 @@ void MergeClusters(Edge* edge,
 // Adds an attribute "_ovtf_cluster" (cluster_id) to each Node that can be
 // encapsulated
 Status AssignClusters(Graph* graph) {
-  std::map<Node*, std::shared_ptr<Cluster>> cluster_map;
+  // Dense by node id, so the contraction does not search maps
+  ClusterMap cluster_map(graph->num_node_ids());
 
   std::unique_ptr<DeadnessAnalysis> deadness_analyzer;
   TF_RETURN_IF_ERROR(DeadnessAnalysis::Run(*graph, &deadness_analyzer));
-  // This map is used only for error checking
-  std::map<Node*, std::string> nodes_predicate_map;
+  const DeadnessAnalysis& deadness = *deadness_analyzer;
+  // The predicates of the nodes are used only for error checking
+  std::vector<DeadnessAnalysis::PredicateHandle> node_predicates(
+      graph->num_node_ids(), DeadnessAnalysis::kNoPredicate);
 
   GraphCycles gc;
 
   // Initial Step: Each node is a cluster of its own
   for (auto node : graph->nodes()) {
     int new_index = gc.NewNode();
-    cluster_map[node] = std::make_shared<Cluster>();
-    cluster_map[node]->index = new_index;
-    cluster_map[node]->nodes.insert(node);
+    auto& cluster = cluster_map[node->id()];
+    cluster = std::make_shared<Cluster>();
+    cluster->index = new_index;
+    cluster->nodes.push_back(node);
     OVTF_VLOG(5) << "Creating graphcycle Node: " << new_index << " for "
                  << node->name() << "[" << node->type_string() << "]";
 
-    // get predicate string for the node
-    string pred_string;
-    TF_RETURN_IF_ERROR(deadness_analyzer->GetNodePredicate(*node, pred_string));
-    nodes_predicate_map[node] = pred_string;
-    cluster_map[node]->predicate_string = pred_string;
+    // The predicate string is only built for logging
+    TF_RETURN_IF_ERROR(deadness_analyzer->GetNodePredicate(
+        *node, node_predicates[node->id()]));
+    cluster->predicate = node_predicates[node->id()];
 
-    cluster_map[node]->outgoing_edges = std::set<const Edge*>(
-        node->out_edges().begin(), node->out_edges().end());
+    cluster->outgoing_edges = std::set<const Edge*>(node->out_edges().begin(),
+                                                    node->out_edges().end());
     OVTF_VLOG(5) << node->name() << "[" << node->type_string() << "]"
-                 << "  : Predicate " << pred_string;
+                 << "  : Predicate "
+                 << deadness.PredicateString(cluster->predicate);
   }
 
   // Check for existing cyclicity in the graph
@@ -322,7 +327,8 @@ Status AssignClusters(Graph* graph) {
       continue;
     }
 
-    if (!gc.InsertEdge(cluster_map[src]->index, cluster_map[dst]->index)) {
+    if (!gc.InsertEdge(cluster_map[src->id()]->index,
+                       cluster_map[dst->id()]->index)) {
       OVTF_VLOG(5) << "Failing due to cycle";
       return errors::Unimplemented(
           "Input graph has a cycle (inserting an edge from ",
@@ -368,9 +374,9 @@ Status AssignClusters(Graph* graph) {
         if (static_edge->src()->type_string() != "Const") {
           int shadow_node_index = gc.NewNode();
           bool gc_success = gc.InsertEdge(
-              cluster_map[static_edge->src()]->index, shadow_node_index);
+              cluster_map[static_edge->src()->id()]->index, shadow_node_index);
           gc_success &= gc.InsertEdge(shadow_node_index,
-                                      cluster_map[static_edge->dst()]->index);
+                                      cluster_map[static_edge->dst()->id()]->index);
           if (!gc_success)
             return errors::Internal(
                 "Unable to create shadow edges in GraphCycles");
@@ -380,8 +386,6 @@ Status AssignClusters(Graph* graph) {
   }
 
   OVTF_VLOG(2) << "Starting contraction";
-  bool changed;
-  bool collect_non_contracting_edge_info = false;  // Must init with false
 
   // 6 exhaustive reasons why edges might non contract
   // The reasons are not mutually exclusive, but there is an order of priority
@@ -437,8 +441,8 @@ Status AssignClusters(Graph* graph) {
         continue;
       }
       bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
+      TF_RETURN_IF_ERROR(CanContractEdgeDeadnessCheck(
+          edge, cluster_map, deadness, is_deadness_ok));
       if (!is_deadness_ok) {
         if (src->type_string() == "Const" && dst->type_string() == "Sub") {
           dst->ClearAttr("_ovtf_marked_for_clustering");
@@ -448,8 +452,8 @@ Status AssignClusters(Graph* graph) {
         }
         continue;
       }
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+      int src_index = cluster_map[src->id()]->index;
+      int dst_index = cluster_map[dst->id()]->index;
       if (!(gc.HasEdge(src_index, dst_index) &&
             gc.CanContractEdge(src_index, dst_index))) {
         if (src->type_string() == "Const" && dst->type_string() == "Sub") {
@@ -478,16 +482,16 @@ Status AssignClusters(Graph* graph) {
         continue;
       }
       bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
+      TF_RETURN_IF_ERROR(CanContractEdgeDeadnessCheck(
+          edge, cluster_map, deadness, is_deadness_ok));
       if (!is_deadness_ok) {
         if (src->type_string() == "Greater") {
           src->ClearAttr("_ovtf_marked_for_clustering");
         }
         continue;
       }
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+      int src_index = cluster_map[src->id()]->index;
+      int dst_index = cluster_map[dst->id()]->index;
       if (!(gc.HasEdge(src_index, dst_index) &&
             gc.CanContractEdge(src_index, dst_index))) {
         if (src->type_string() == "Greater") {
@@ -497,132 +501,205 @@ Status AssignClusters(Graph* graph) {
     }
   }
 
-  do {
-    changed = false;
-
-    auto log_reason = [](EdgeNonContractionReasons reason, Edge* edge) {
-      OVTF_VLOG(0) << "NONCONTRACTION: " << reason_string[reason] << ": "
-                   << edge->src()->name() << "<" << edge->src()->type_string()
-                   << ">"
-                   << "[" << edge->src_output() << "] -> "
-                   << edge->dst()->name() << "<" << edge->dst()->type_string()
-                   << ">"
-                   << "[" << edge->dst_input() << "]";
-    };
+  // Looking the marks up in the node attributes on every attempt is slow on
+  // large graphs
+  std::vector<bool> marked(graph->num_node_ids(), false);
+  for (auto node : graph->nodes()) {
+    marked[node->id()] = NodeIsMarkedForClustering(node);
+  }
 
-    for (auto edge : graph->edges()) {
-      Node* src = edge->src();
-      Node* dst = edge->dst();
+  auto log_reason = [](EdgeNonContractionReasons reason, const Edge* edge) {
+    OVTF_VLOG(0) << "NONCONTRACTION: " << reason_string[reason] << ": "
+                 << edge->src()->name() << "<" << edge->src()->type_string()
+                 << ">"
+                 << "[" << edge->src_output() << "] -> "
+                 << edge->dst()->name() << "<" << edge->dst()->type_string()
+                 << ">"
+                 << "[" << edge->dst_input() << "]";
+  };
 
-      int src_index = cluster_map[src]->index;
-      int dst_index = cluster_map[dst]->index;
+  // Contracts the edge if its clusters can be merged, and sets removed to the
+  // cluster that was merged away. Records why the edge was not contracted
+  // when collect_non_contracting_edge_info is set.
+  auto contract_edge = [&](const Edge* edge,
+                           bool collect_non_contracting_edge_info,
+                           std::shared_ptr<Cluster>& removed) -> Status {
+    Node* src = edge->src();
+    Node* dst = edge->dst();
 
-      if (!src->IsOp() || !dst->IsOp()) {
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::NOTANOP, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::NOTANOP);
-        }
-        continue;
+    int src_index = cluster_map[src->id()]->index;
+    int dst_index = cluster_map[dst->id()]->index;
+
+    if (!src->IsOp() || !dst->IsOp()) {
+      if (collect_non_contracting_edge_info) {
+        log_reason(EdgeNonContractionReasons::NOTANOP, edge);
+        cluster_separation_reason[get_string_key(src_index, dst_index)]
+            .push_back(EdgeNonContractionReasons::NOTANOP);
       }
+      return Status::OK();
+    }
 
-      if (!NodeIsMarkedForClustering(src) || !NodeIsMarkedForClustering(dst)) {
-        OVTF_VLOG(5) << "Skipping (not marked): " << src->name() << "["
-                     << edge->src_output() << "]@" << src_index << " -> "
-                     << dst->name() << "[" << edge->dst_input() << "]@"
-                     << dst_index;
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::UNSUPPORTED, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::UNSUPPORTED);
-        }
-        continue;
+    if (!marked[src->id()] || !marked[dst->id()]) {
+      OVTF_VLOG(5) << "Skipping (not marked): " << src->name() << "["
+                   << edge->src_output() << "]@" << src_index << " -> "
+                   << dst->name() << "[" << edge->dst_input() << "]@"
+                   << dst_index;
+      if (collect_non_contracting_edge_info) {
+        log_reason(EdgeNonContractionReasons::UNSUPPORTED, edge);
+        cluster_separation_reason[get_string_key(src_index, dst_index)]
+            .push_back(EdgeNonContractionReasons::UNSUPPORTED);
       }
+      return Status::OK();
+    }
 
-      // check if the edge can be contracted with respect to deadness
-      bool is_deadness_ok = false;
-      TF_RETURN_IF_ERROR(
-          CanContractEdgeDeadnessCheck(edge, cluster_map, is_deadness_ok));
-      if (!is_deadness_ok) {
-        // do not contract, src and dst node cannot be in the same cluster
-        OVTF_VLOG(5) << "Skipping (deadness not ok): " << src->name() << "["
-                     << edge->src_output() << "]@" << src_index << " -> "
-                     << dst->name() << "[" << edge->dst_input() << "]@"
-                     << dst_index;
-        if (collect_non_contracting_edge_info) {
-          log_reason(EdgeNonContractionReasons::DEADNESS, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(EdgeNonContractionReasons::DEADNESS);
-
-          auto src_cluster = cluster_map[src];
-          auto dst_cluster = cluster_map[dst];
-          vector<string> neighbours_predicate;
-          // Collect predicates of src's neighbours (except dst)
-          for (const Edge* src_cluster_edge : src_cluster->outgoing_edges) {
-            if (src_cluster_edge != edge) {
-              neighbours_predicate.push_back(
-                  cluster_map[src_cluster_edge->dst()]->predicate_string);
-            }
+    // check if the edge can be contracted with respect to deadness
+    bool is_deadness_ok = false;
+    TF_RETURN_IF_ERROR(CanContractEdgeDeadnessCheck(edge, cluster_map,
+                                                    deadness, is_deadness_ok));
+    if (!is_deadness_ok) {
+      // do not contract, src and dst node cannot be in the same cluster
+      OVTF_VLOG(5) << "Skipping (deadness not ok): " << src->name() << "["
+                   << edge->src_output() << "]@" << src_index << " -> "
+                   << dst->name() << "[" << edge->dst_input() << "]@"
+                   << dst_index;
+      if (collect_non_contracting_edge_info) {
+        log_reason(EdgeNonContractionReasons::DEADNESS, edge);
+        cluster_separation_reason[get_string_key(src_index, dst_index)]
+            .push_back(EdgeNonContractionReasons::DEADNESS);
+
+        auto src_cluster = cluster_map[src->id()];
+        auto dst_cluster = cluster_map[dst->id()];
+        vector<string> neighbours_predicate;
+        // Collect predicates of src's neighbours (except dst)
+        for (const Edge* src_cluster_edge : src_cluster->outgoing_edges) {
+          if (src_cluster_edge != edge) {
+            neighbours_predicate.push_back(deadness.PredicateString(
+                cluster_map[src_cluster_edge->dst()->id()]->predicate));
           }
-          deadness_info[get_string_key(src_index, dst_index)] = make_tuple(
-              cluster_map.at(src)->predicate_string,
-              cluster_map.at(dst)->predicate_string, neighbours_predicate);
         }
-        continue;
+        deadness_info[get_string_key(src_index, dst_index)] =
+            make_tuple(deadness.PredicateString(src_cluster->predicate),
+                       deadness.PredicateString(dst_cluster->predicate),
+                       neighbours_predicate);
       }
+      return Status::OK();
+    }
 
-      // Check if contracting the edge will lead to cycles
-      // if not, MergeClusters
-      if (gc.HasEdge(src_index, dst_index) &&
-          gc.ContractEdge(src_index, dst_index)) {
-        MergeClusters(edge, cluster_map);
-        // something changed
-        changed = true;
-      } else {
-        if (collect_non_contracting_edge_info) {
-          // either static input
-          // or there exists a longer path, so contracting this edge causes
-          // cycles
-          std::vector<int32> static_inputs;
-          GetStaticInputs(dst, &static_inputs);
-          bool is_static = std::find(static_inputs.begin(), static_inputs.end(),
-                                     edge->dst_input()) != static_inputs.end();
-          bool is_not_const = src->type_string() != "Const";
-          // 3 possible reasons here:
-          // src dst lies in same cluster, so nothing to do (trivial cycle
-          // induced in graphcycles)
-          // dst has static input
-          // a longer irreducible path exists
-          auto reason = (src_index == dst_index
-                             ? EdgeNonContractionReasons::SAMECLUSTER
-                             : ((is_not_const && is_static)
-                                    ? EdgeNonContractionReasons::STATICINPUT
-                                    : EdgeNonContractionReasons::PATHEXISTS));
-          log_reason(reason, edge);
-          cluster_separation_reason[get_string_key(src_index, dst_index)]
-              .push_back(reason);
-        }
+    // Check if contracting the edge will lead to cycles
+    // if not, MergeClusters
+    int merged_index;
+    if (gc.HasEdge(src_index, dst_index) &&
+        gc.ContractEdge(src_index, dst_index, &merged_index)) {
+      removed = MergeClusters(edge, merged_index, cluster_map, deadness);
+    } else {
+      if (collect_non_contracting_edge_info) {
+        // either static input
+        // or there exists a longer path, so contracting this edge causes
+        // cycles
+        std::vector<int32> static_inputs;
+        GetStaticInputs(dst, &static_inputs);
+        bool is_static = std::find(static_inputs.begin(), static_inputs.end(),
+                                   edge->dst_input()) != static_inputs.end();
+        bool is_not_const = src->type_string() != "Const";
+        // 3 possible reasons here:
+        // src dst lies in same cluster, so nothing to do (trivial cycle
+        // induced in graphcycles)
+        // dst has static input
+        // a longer irreducible path exists
+        auto reason = (src_index == dst_index
+                           ? EdgeNonContractionReasons::SAMECLUSTER
+                           : ((is_not_const && is_static)
+                                  ? EdgeNonContractionReasons::STATICINPUT
+                                  : EdgeNonContractionReasons::PATHEXISTS));
+        log_reason(reason, edge);
+        cluster_separation_reason[get_string_key(src_index, dst_index)]
+            .push_back(reason);
       }
     }
+    return Status::OK();
+  };
 
-    if (!changed && api::IsLoggingPlacement()) {
-      // This will be entered only once if logging is enabled
-      // When entered, it will force the do-while to run one last time,
-      // collecting information
-      if (!collect_non_contracting_edge_info) {
-        changed = true;
-        collect_non_contracting_edge_info = true;
+  // All edges are examined once, in graph order. Contracting an edge can
+  // only make the edges at the merged cluster contractible:
+  //  - a cluster adjacent to both merged clusters may no longer be reachable
+  //    through another path, and it is adjacent to the nodes of the smaller
+  //    one, whose edges are examined again;
+  //  - if the predicate of the merged cluster changed, the edges of all its
+  //    nodes and the outgoing edges of the clusters feeding it are examined
+  //    again. A cluster changes its predicate at most once, from True.
+  // Every other edge keeps its outcome, so the contraction reaches the same
+  // kind of fixed point as sweeping all edges until nothing changes.
+  std::deque<const Edge*> worklist;
+  std::vector<bool> in_worklist(graph->num_edge_ids(), false);
+  auto push_edge = [&worklist, &in_worklist](const Edge* edge) {
+    if (!in_worklist[edge->id()]) {
+      in_worklist[edge->id()] = true;
+      worklist.push_back(edge);
+    }
+  };
+  auto push_node_edges = [&push_edge](const Node* node) {
+    for (auto edge : node->in_edges()) push_edge(edge);
+    for (auto edge : node->out_edges()) push_edge(edge);
+  };
+  for (auto edge : graph->edges()) {
+    push_edge(edge);
+  }
+
+  int64 num_attempts = 0;
+  while (!worklist.empty()) {
+    const Edge* edge = worklist.front();
+    worklist.pop_front();
+    in_worklist[edge->id()] = false;
+    num_attempts++;
+
+    auto src_predicate = cluster_map[edge->src()->id()]->predicate;
+    auto dst_predicate = cluster_map[edge->dst()->id()]->predicate;
+    std::shared_ptr<Cluster> removed;
+    TF_RETURN_IF_ERROR(contract_edge(edge, false, removed));
+    if (removed == nullptr) continue;
+
+    for (auto node : removed->nodes) {
+      push_node_edges(node);
+    }
+    auto merged = cluster_map[edge->src()->id()];
+    if (merged->predicate != src_predicate ||
+        merged->predicate != dst_predicate) {
+      for (auto node : merged->nodes) {
+        push_node_edges(node);
+        for (auto in_edge : node->in_edges()) {
+          for (auto neighbour_edge :
+               cluster_map[in_edge->src()->id()]->outgoing_edges) {
+            push_edge(neighbour_edge);
+          }
+        }
       }
     }
-  } while (changed);
+  }
+  OVTF_VLOG(2) << "Contraction done after " << num_attempts
+               << " edge contraction attempts for " << graph->num_edges()
+               << " edges";
 
-  OVTF_VLOG(2) << "Contraction done";
+  if (api::IsLoggingPlacement()) {
+    // Collect why the remaining edges were not contracted. Should an edge
+    // still contract, the collection starts over.
+    bool contracted;
+    do {
+      contracted = false;
+      cluster_separation_reason.clear();
+      deadness_info.clear();
+      for (auto edge : graph->edges()) {
+        std::shared_ptr<Cluster> removed;
+        TF_RETURN_IF_ERROR(contract_edge(edge, true, removed));
+        contracted |= removed != nullptr;
+      }
+    } while (contracted);
+  }
 
   OVTF_VLOG(2) << "Starting tagging";
   std::set<Cluster*> seen;
   unordered_map<int, int> cluster_to_encapsulate;
-  for (auto kv : cluster_map) {
-    auto cluster = kv.second.get();
+  for (auto graph_node : graph->nodes()) {
+    auto cluster = cluster_map[graph_node->id()].get();
     if (seen.count(cluster) != 0) {
       continue;
     }
@@ -636,7 +713,7 @@ Status AssignClusters(Graph* graph) {
 
         // Some sanity checks for deadness
         TF_RETURN_IF_ERROR(CheckNodeClusterAssignmentWRTDeadness(
-            node, nodes_predicate_map, cluster_map));
+            node, node_predicates, cluster_map, deadness));
       } else {
         has_non_ovtf_ops = true;
       }
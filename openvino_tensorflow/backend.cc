@@ -66,8 +66,23 @@ Backend::Backend(const string& config) {
   }
 }
 
-shared_ptr<Executable> Backend::Compile(shared_ptr<ov::Model> func, bool) {
-  return make_shared<Executable>(func, m_device, m_device_type);
+shared_ptr<Executable> Backend::Compile(
+    shared_ptr<ov::Model> func, bool,
+    const map<string, string>& compile_properties) {
+  return make_shared<Executable>(func, m_device, m_device_type,
+                                 compile_properties);
+}
+
+shared_ptr<Executable> Backend::Import(std::istream& compiled_model,
+                                       shared_ptr<ov::Model> io_model,
+                                       const vector<int>& skipped_inputs) {
+  if (m_device == "HDDL") return nullptr;
+  auto dev_type = m_device_type;
+  if (dev_type.find("GPU") != string::npos) dev_type = "GPU";
+  auto imported =
+      GetGlobalContext().ie_core.import_model(compiled_model, dev_type);
+  return make_shared<Executable>(io_model, imported, skipped_inputs, m_device,
+                                 m_device_type);
 }
 
 GlobalContext& Backend::GetGlobalContext() {
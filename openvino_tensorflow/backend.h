@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <istream>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "openvino/openvino.hpp"
 
@@ -32,8 +35,16 @@ class Backend {
     ReleaseGlobalContext();
   }
 
-  shared_ptr<Executable> Compile(shared_ptr<ov::Model> func,
-                                 bool enable_performance_data = false);
+  // compile_properties are the api::kCompilePropertyNames applied when the
+  // executable loads the network
+  shared_ptr<Executable> Compile(
+      shared_ptr<ov::Model> func, bool enable_performance_data = false,
+      const map<string, string>& compile_properties = {});
+  // Imports a compiled model exported earlier. io_model describes its
+  // inputs and outputs. Returns nullptr if the device cannot import models.
+  shared_ptr<Executable> Import(std::istream& compiled_model,
+                                shared_ptr<ov::Model> io_model,
+                                const vector<int>& skipped_inputs);
 
   static GlobalContext& GetGlobalContext();
   static void ReleaseGlobalContext();
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/backend_selector.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr size_t BackendSelector::kMaxEntries;
+
+BackendSelector::BackendSelector(int64 num_samples, int64 resample_calls)
+    : m_num_samples(std::max<int64>(num_samples, 1)),
+      m_resample_calls(std::max<int64>(resample_calls, 1)) {}
+
+BackendSelector::Backend BackendSelector::Select(
+    const InputSignature& signature, bool& sample) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(signature);
+  if (it == m_entries.end()) {
+    if (m_entries.size() >= kMaxEntries) m_entries.erase(m_entries.begin());
+    it = m_entries.emplace(signature, Entry()).first;
+  }
+  Entry& entry = it->second;
+  if (entry.pinned) {
+    if (++entry.pinned_calls < m_resample_calls) {
+      sample = false;
+      return entry.backend;
+    }
+    // Sample both again, the first calls are warm by now
+    entry.pinned = false;
+    entry.openvino.count = entry.openvino.total_us = 0;
+    entry.tf.count = entry.tf.total_us = 0;
+  }
+  // Concurrent calls may take more samples than needed, which is harmless
+  sample = true;
+  return entry.openvino.count <= entry.tf.count ? Backend::kOpenVINO
+                                                : Backend::kTF;
+}
+
+void BackendSelector::Record(const InputSignature& signature, Backend backend,
+                             int64 us) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(signature);
+  if (it == m_entries.end() || it->second.pinned) return;
+  Entry& entry = it->second;
+  Samples& samples =
+      backend == Backend::kOpenVINO ? entry.openvino : entry.tf;
+  if (!samples.warm) {
+    samples.warm = true;
+    return;
+  }
+  samples.count++;
+  samples.total_us += us;
+  if (entry.openvino.count < m_num_samples || entry.tf.count < m_num_samples) {
+    return;
+  }
+
+  double openvino_us =
+      static_cast<double>(entry.openvino.total_us) / entry.openvino.count;
+  double tf_us = static_cast<double>(entry.tf.total_us) / entry.tf.count;
+  entry.backend = tf_us < openvino_us ? Backend::kTF : Backend::kOpenVINO;
+  entry.pinned = true;
+  entry.pinned_calls = 0;
+  OVTF_VLOG(1) << "Pinned "
+               << (entry.backend == Backend::kTF ? "TF" : "OpenVINO")
+               << " for " << signature.DebugString() << ": OpenVINO "
+               << openvino_us << " us, TF " << tf_us << " us per call";
+}
+
+bool BackendSelector::GetPinned(const InputSignature& signature,
+                                Backend& backend) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_entries.find(signature);
+  if (it == m_entries.end() || !it->second.pinned) return false;
+  backend = it->second.backend;
+  return true;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
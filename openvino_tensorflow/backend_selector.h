@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_BACKEND_SELECTOR_H_
+#define OPENVINO_TF_BACKEND_SELECTOR_H_
+
+#include <mutex>
+#include <unordered_map>
+
+#include "openvino_tensorflow/input_signature.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Chooses whether the calls of a cluster run with OpenVINO or on the native
+// TF fallback session, separately for each input signature since the faster
+// one depends on the shapes.
+//
+// The calls of a new signature alternate between both until each has run
+// num_samples timed calls, then the faster one is pinned. The first call on
+// each side is not timed, it includes the compilation or the session setup.
+// A pinned signature is sampled again after resample_calls calls.
+class BackendSelector {
+ public:
+  enum class Backend { kOpenVINO, kTF };
+
+  BackendSelector(int64 num_samples, int64 resample_calls);
+
+  // Returns the backend of the next call with the signature, and whether
+  // its time has to be passed to Record
+  Backend Select(const InputSignature& signature, bool& sample);
+  // Records the time of a sampled call
+  void Record(const InputSignature& signature, Backend backend, int64 us);
+
+  // Returns true and sets backend if the signature is pinned
+  bool GetPinned(const InputSignature& signature, Backend& backend);
+
+ private:
+  struct Samples {
+    int64 count = 0;
+    int64 total_us = 0;
+    // Set once the untimed first call has run
+    bool warm = false;
+  };
+  struct Entry {
+    Samples openvino;
+    Samples tf;
+    bool pinned = false;
+    Backend backend = Backend::kOpenVINO;
+    int64 pinned_calls = 0;
+  };
+
+  // Signatures tracked at most, further ones evict an arbitrary entry
+  static constexpr size_t kMaxEntries = 256;
+
+  const int64 m_num_samples;
+  const int64 m_resample_calls;
+  std::mutex m_mutex;
+  std::unordered_map<InputSignature, Entry, InputSignature::Hasher> m_entries;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_BACKEND_SELECTOR_H_
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "openvino/core/validation_util.hpp"
+
+#include "openvino_tensorflow/batch_analysis.h"
+#include "openvino_tensorflow/default_opset.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+namespace {
+
+// The batch sizes the model is reshaped to, unlikely to match other dims
+constexpr int64_t kFirstBatch = 7;
+constexpr int64_t kSecondBatch = 13;
+constexpr int64_t kNoBatch = -1;
+
+using OutputKey = std::pair<const ov::Node*, size_t>;
+
+OutputKey Key(const ov::Output<ov::Node>& output) {
+  return {output.get_node(), output.get_index()};
+}
+
+std::string Describe(const std::shared_ptr<ov::Node>& node) {
+  return std::string(node->get_type_name()) + " " + node->get_friendly_name();
+}
+
+void SetBatch(const std::shared_ptr<ov::Model>& model, int64_t batch) {
+  std::map<ov::Output<ov::Node>, ov::PartialShape> shapes;
+  for (const auto& param : model->get_parameters()) {
+    ov::PartialShape shape = param->get_partial_shape();
+    if (shape.rank().is_dynamic() || shape.rank().get_length() == 0) {
+      throw std::runtime_error("parameter " + param->get_friendly_name() +
+                               " has no batch dim");
+    }
+    shape[0] = batch;
+    shapes[param->output(0)] = shape;
+  }
+  model->reshape(shapes);
+}
+
+// Reads the axes an op takes as a constant input
+bool GetConstantAxes(const ov::Output<ov::Node>& source,
+                     std::vector<int64_t>& axes) {
+  auto constant = ov::get_constant_from_source(source);
+  if (constant == nullptr) return false;
+  axes = constant->cast_vector<int64_t>();
+  return true;
+}
+
+// Returns true if the op combines the values of its first input along some
+// of its dims while keeping them, and sets these dims. Dims that are not
+// known are all reported.
+bool GetCombinedDims(const std::shared_ptr<ov::Node>& node, int64_t rank,
+                     std::vector<int64_t>& dims) {
+  bool known = true;
+  if (auto softmax = ov::as_type_ptr<opset::Softmax>(node)) {
+    dims = {static_cast<int64_t>(softmax->get_axis())};
+  } else if (auto log_softmax = ov::as_type_ptr<opset::LogSoftmax>(node)) {
+    dims = {log_softmax->get_axis()};
+  } else if (ov::is_type<opset::CumSum>(node) ||
+             ov::is_type<opset::MVN>(node) ||
+             ov::is_type<opset::NormalizeL2>(node) ||
+             ov::is_type<opset::LRN>(node)) {
+    known = GetConstantAxes(node->input_value(1), dims);
+  } else if (ov::is_type<opset::Roll>(node)) {
+    known = GetConstantAxes(node->input_value(2), dims);
+  } else if (auto reverse = ov::as_type_ptr<opset::Reverse>(node)) {
+    std::vector<int64_t> axes;
+    known = GetConstantAxes(node->input_value(1), axes);
+    if (known && reverse->get_mode() == opset::Reverse::Mode::MASK) {
+      dims.clear();
+      for (int64_t i = 0; i < axes.size(); i++) {
+        if (axes[i] != 0) dims.push_back(i);
+      }
+    } else {
+      dims = axes;
+    }
+  } else if (auto gather = ov::as_type_ptr<opset::Gather>(node)) {
+    dims = {gather->get_axis()};
+  } else if (auto gather_elements =
+                 ov::as_type_ptr<opset::GatherElements>(node)) {
+    dims = {gather_elements->get_axis()};
+  } else if (auto reverse_sequence =
+                 ov::as_type_ptr<opset::ReverseSequence>(node)) {
+    dims = {static_cast<int64_t>(reverse_sequence->get_sequence_axis())};
+  } else if (ov::is_type<opset::GatherND>(node) ||
+             ov::is_type<opset::ScatterUpdate>(node) ||
+             ov::is_type<opset::ScatterElementsUpdate>(node) ||
+             ov::is_type<opset::ScatterNDUpdate>(node)) {
+    known = false;
+  } else {
+    return false;
+  }
+  if (!known) {
+    dims.clear();
+    for (int64_t d = 0; d < rank; d++) dims.push_back(d);
+  }
+  for (auto& dim : dims) {
+    if (dim < 0) dim += rank;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool BatchAnalysis::RowsAreIndependent(
+    const std::shared_ptr<const ov::Model>& model, std::string& reason) {
+  if (model->get_parameters().empty()) {
+    reason = "the model has no parameters";
+    return false;
+  }
+
+  // The same nodes are reshaped twice, so the shapes of the first batch size
+  // are recorded by node
+  auto clone = model->clone();
+  std::map<OutputKey, ov::PartialShape> first_shapes;
+  try {
+    SetBatch(clone, kFirstBatch);
+    for (const auto& node : clone->get_ordered_ops()) {
+      for (const auto& output : node->outputs()) {
+        first_shapes[Key(output)] = output.get_partial_shape();
+      }
+    }
+    SetBatch(clone, kSecondBatch);
+  } catch (const std::exception& ex) {
+    reason = std::string("the batch cannot be changed: ") + ex.what();
+    return false;
+  }
+
+  std::map<OutputKey, int64_t> batch_dims;
+  for (const auto& node : clone->get_ordered_ops()) {
+    int64_t input_batch_dim = kNoBatch;
+    bool batched_input = false;
+    for (size_t i = 0; i < node->get_input_size(); i++) {
+      auto it = batch_dims.find(Key(node->input_value(i)));
+      if (it == batch_dims.end() || it->second == kNoBatch) continue;
+      batched_input = true;
+      if (i == 0) input_batch_dim = it->second;
+    }
+
+    bool batched_output = false;
+    for (const auto& output : node->outputs()) {
+      const auto& first = first_shapes[Key(output)];
+      const auto& second = output.get_partial_shape();
+      if (first.is_dynamic() || second.is_dynamic() ||
+          first.rank() != second.rank()) {
+        reason = Describe(node) + " has a dynamic shape";
+        return false;
+      }
+      int64_t batch_dim = kNoBatch;
+      for (int64_t d = 0; d < first.rank().get_length(); d++) {
+        if (first[d] == second[d]) continue;
+        if (first[d].get_length() != kFirstBatch ||
+            second[d].get_length() != kSecondBatch) {
+          reason = Describe(node) + " has a dim that changes with the batch";
+          return false;
+        }
+        if (batch_dim != kNoBatch) {
+          reason = Describe(node) + " has the batch in more than one dim";
+          return false;
+        }
+        batch_dim = d;
+      }
+      batch_dims[Key(output)] = batch_dim;
+      batched_output |= batch_dim != kNoBatch;
+    }
+
+    // Shapes are the only values that do not depend on single rows
+    if (batched_input && !batched_output &&
+        !ov::is_type<ov::op::v0::ShapeOf>(node) &&
+        !ov::is_type<ov::op::v3::ShapeOf>(node)) {
+      reason = Describe(node) + " reduces the batch";
+      return false;
+    }
+
+    std::vector<int64_t> combined_dims;
+    if (input_batch_dim != kNoBatch &&
+        GetCombinedDims(node,
+                        node->get_input_partial_shape(0).rank().get_length(),
+                        combined_dims) &&
+        std::find(combined_dims.begin(), combined_dims.end(),
+                  input_batch_dim) != combined_dims.end()) {
+      reason = Describe(node) + " combines the rows of the batch";
+      return false;
+    }
+  }
+
+  for (const auto& result : clone->get_results()) {
+    if (batch_dims[Key(result->output(0))] != 0) {
+      reason = "result " + result->get_friendly_name() +
+               " does not have the batch as its dim 0";
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_BATCH_ANALYSIS_H_
+#define OPENVINO_TF_BATCH_ANALYSIS_H_
+
+#include <memory>
+#include <string>
+
+#include "openvino/core/model.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Proves that a model computes the rows of its batch independently of each
+// other. Padding a batch, splitting it across requests and concatenating the
+// calls of several callers all rely on this. Dim 0 of every parameter is
+// taken as the batch.
+//
+// The model is reshaped to two batch sizes and the dim that carries the
+// batch is followed through every op by comparing the shapes. The rows are
+// independent if
+//  - no tensor has a dim that changes with the batch without being the
+//    batch, e.g. after a Concat along it or a Reshape that merges it,
+//  - no tensor has the batch in more than one dim, e.g. x * transpose(x),
+//  - no op drops the batch of its inputs, e.g. a reduction over it,
+//  - no op combines values along the batch dim, e.g. Softmax, CumSum or
+//    Gather along it,
+//  - every result has the batch as its dim 0.
+// Models that cannot be reshaped, e.g. because a Reshape has the batch in
+// its constant target shape, are not independent.
+class BatchAnalysis {
+ public:
+  // Returns true if the rows are independent, otherwise sets reason
+  static bool RowsAreIndependent(const std::shared_ptr<const ov::Model>& model,
+                                 std::string& reason);
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_BATCH_ANALYSIS_H_
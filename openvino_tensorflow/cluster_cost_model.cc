@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/types.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/cluster_cost_model.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Dispatch cost of an op run by the TF executor, and of a node inside a
+// compiled OpenVINO model
+static const double kTFOpOverheadNs = 5000;
+static const double kOVOpOverheadNs = 500;
+static const double kTFFlopsPerNs = 20;
+// Host memory bandwidth
+static const double kBytesPerNs = 10;
+
+ClusterCostModel::DeviceRates ClusterCostModel::GetDeviceRates(
+    const string& device) {
+  if (device.find("GPU") == 0) {
+    return DeviceRates{200, 50000, 5000, 8};
+  } else if (device == "MYRIAD" || device == "HDDL" || device == "VAD-M") {
+    return DeviceRates{50, 200000, 20000, 1};
+  }
+  // The CPU shares the boundary tensors with TF
+  return DeviceRates{40, 25000, 200, 0};
+}
+
+ClusterCostModel::ClusterCostModel(const Graph* graph,
+                                   const GraphShapes& shapes,
+                                   const string& device)
+    : m_graph(graph), m_shapes(shapes), m_rates(GetDeviceRates(device)) {}
+
+const PartialTensorShape& ClusterCostModel::OutputShape(const Node* node,
+                                                        int index) const {
+  return m_shapes.OutputShape(node->id(), index);
+}
+
+int64 ClusterCostModel::NumElements(const PartialTensorShape& shape) {
+  int64 elements = 1;
+  for (int i = 0; i < shape.dims(); i++) {
+    elements *= std::max<int64>(shape.dim_size(i), 1);
+  }
+  return elements;
+}
+
+int64 ClusterCostModel::OutputBytes(const Node* node, int index) const {
+  return NumElements(OutputShape(node, index)) *
+         DataTypeSize(BaseType(node->output_type(index)));
+}
+
+int64 ClusterCostModel::EstimateFlops(const Node* node) const {
+  const string& op = node->type_string();
+  int64 outputs =
+      node->num_outputs() > 0 ? NumElements(OutputShape(node, 0)) : 0;
+  auto input_shape = [this, node](int index) -> PartialTensorShape {
+    const Edge* edge;
+    if (!node->input_edge(index, &edge).ok()) return PartialTensorShape();
+    return OutputShape(edge->src(), edge->src_output());
+  };
+
+  if (op == "MatMul" || op == "BatchMatMul" || op == "BatchMatMulV2" ||
+      op == "BatchMatMulV3") {
+    PartialTensorShape a = input_shape(0);
+    if (a.dims() < 2) return outputs;
+    bool transposed = false;
+    if (!GetNodeAttr(node->attrs(), "transpose_a", &transposed).ok()) {
+      GetNodeAttr(node->attrs(), "adj_x", &transposed);
+    }
+    int64 inner = a.dim_size(transposed ? a.dims() - 2 : a.dims() - 1);
+    return 2 * outputs * std::max<int64>(inner, 1);
+  }
+  if (op == "Conv2D" || op == "Conv3D" || op == "DepthwiseConv2dNative") {
+    PartialTensorShape filter = input_shape(1);
+    if (filter.dims() < 3) return outputs;
+    // Multiply-adds per output: the filter window, across all input
+    // channels unless the convolution is depthwise
+    int last = filter.dims() - (op == "DepthwiseConv2dNative" ? 2 : 1);
+    int64 window = 1;
+    for (int i = 0; i < last; i++) {
+      window *= std::max<int64>(filter.dim_size(i), 1);
+    }
+    return 2 * outputs * window;
+  }
+  if (op == "MaxPool" || op == "AvgPool" || op == "MaxPool3D" ||
+      op == "AvgPool3D") {
+    std::vector<int32> ksize;
+    if (!GetNodeAttr(node->attrs(), "ksize", &ksize).ok()) return outputs;
+    int64 window = 1;
+    for (auto k : ksize) window *= std::max(k, 1);
+    return outputs * window;
+  }
+  if (op == "Sum" || op == "Mean" || op == "Max" || op == "Min" ||
+      op == "Prod" || op == "All" || op == "Any" || op == "ArgMax" ||
+      op == "ArgMin") {
+    return std::max(outputs, NumElements(input_shape(0)));
+  }
+  if (op == "Softmax" || op == "LogSoftmax") {
+    return 5 * outputs;
+  }
+  return outputs;
+}
+
+ClusterCostModel::Estimate ClusterCostModel::EstimateCluster(
+    const std::set<Node*>& nodes) const {
+  // Ops that neither TF nor OpenVINO spend time on
+  static const std::set<string> trivial_ops = {"Const", "Identity", "NoOp",
+                                               "Snapshot"};
+  Estimate estimate;
+  std::set<std::pair<int, int>> boundary_outputs;
+  for (auto node : nodes) {
+    if (!node->IsOp()) continue;
+    for (auto edge : node->in_edges()) {
+      if (!edge->IsControlEdge() && nodes.count(edge->src()) == 0) {
+        boundary_outputs.emplace(edge->src()->id(), edge->src_output());
+      }
+    }
+    for (auto edge : node->out_edges()) {
+      if (!edge->IsControlEdge() && nodes.count(edge->dst()) == 0) {
+        boundary_outputs.emplace(node->id(), edge->src_output());
+      }
+    }
+    if (trivial_ops.count(node->type_string())) continue;
+
+    int64 flops = EstimateFlops(node);
+    int64 bytes = 0;
+    for (int i = 0; i < node->num_outputs(); i++) {
+      bytes += OutputBytes(node, i);
+    }
+    for (auto edge : node->in_edges()) {
+      if (!edge->IsControlEdge()) {
+        bytes += OutputBytes(edge->src(), edge->src_output());
+      }
+    }
+    estimate.num_ops++;
+    estimate.flops += flops;
+    estimate.bytes += bytes;
+    estimate.tf_ns +=
+        kTFOpOverheadNs + flops / kTFFlopsPerNs + bytes / kBytesPerNs;
+    estimate.ov_ns += kOVOpOverheadNs + flops / m_rates.ov_flops_per_ns;
+  }
+
+  for (auto& output : boundary_outputs) {
+    estimate.boundary_tensors++;
+    estimate.boundary_bytes +=
+        OutputBytes(m_graph->FindNodeId(output.first), output.second);
+  }
+  // The fused model still reads its inputs and writes its outputs once
+  estimate.ov_ns += estimate.boundary_bytes / kBytesPerNs;
+  estimate.call_overhead_ns = m_rates.call_overhead_ns;
+  estimate.transfer_ns =
+      estimate.boundary_tensors * m_rates.transfer_overhead_ns;
+  if (m_rates.transfer_bytes_per_ns > 0) {
+    estimate.transfer_ns +=
+        estimate.boundary_bytes / m_rates.transfer_bytes_per_ns;
+  }
+  return estimate;
+}
+
+string ClusterCostModel::Estimate::DebugString() const {
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(1) << "gain " << Gain() / 1000
+     << " us (TF " << tf_ns / 1000 << " us, OpenVINO " << ov_ns / 1000
+     << " us, call " << call_overhead_ns / 1000 << " us, transfer of "
+     << boundary_tensors << " tensors of " << boundary_bytes / 1024 << " KB "
+     << transfer_ns / 1000 << " us; " << num_ops << " ops, "
+     << flops / 1000000.0 << " MFLOP)";
+  return ss.str();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CLUSTER_COST_MODEL_H_
+#define OPENVINO_TF_CLUSTER_COST_MODEL_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/graph.h"
+
+#include "openvino_tensorflow/graph_shapes.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Predicts whether offloading a cluster to OpenVINO pays for itself. The
+// ops of the cluster are scored with FLOP and memory traffic estimates
+// derived from the statically inferred shapes of the graph, and a fixed
+// dispatch cost per op when run by TF. Running the cluster with OpenVINO
+// costs the same FLOPs at the device rate, a fixed overhead per encapsulate
+// call and the transfer of every tensor that crosses the cluster boundary.
+//
+// The rates are rough per-device defaults meant to rank clusters, not to
+// predict run times. Dimensions that are unknown at rewrite time count as 1,
+// so a cluster of unknown shapes is judged on its op count.
+class ClusterCostModel {
+ public:
+  struct Estimate {
+    int64 num_ops = 0;
+    int64 flops = 0;
+    int64 bytes = 0;
+    int64 boundary_tensors = 0;
+    int64 boundary_bytes = 0;
+    // Predicted time of one call, in nanoseconds
+    double tf_ns = 0;
+    double ov_ns = 0;
+    double call_overhead_ns = 0;
+    double transfer_ns = 0;
+
+    // Time saved by one call on OpenVINO, negative if it is slower
+    double Gain() const {
+      return tf_ns - ov_ns - call_overhead_ns - transfer_ns;
+    }
+    std::string DebugString() const;
+  };
+
+  // The graph and its inferred shapes must outlive the model
+  ClusterCostModel(const Graph* graph, const GraphShapes& shapes,
+                   const std::string& device);
+
+  Estimate EstimateCluster(const std::set<Node*>& nodes) const;
+
+ private:
+  struct DeviceRates {
+    double ov_flops_per_ns;
+    double call_overhead_ns;
+    double transfer_overhead_ns;
+    // 0 if the tensors are shared with TF without a copy
+    double transfer_bytes_per_ns;
+  };
+
+  // Shape of an output of a node, unknown dimensions are -1
+  const PartialTensorShape& OutputShape(const Node* node, int index) const;
+  static int64 NumElements(const PartialTensorShape& shape);
+  int64 OutputBytes(const Node* node, int index) const;
+  int64 EstimateFlops(const Node* node) const;
+
+  static DeviceRates GetDeviceRates(const std::string& device);
+
+  const Graph* m_graph;
+  const GraphShapes& m_shapes;
+  DeviceRates m_rates;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CLUSTER_COST_MODEL_H_
@@ -0,0 +1,248 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/cluster_profile.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr int64 ClusterProfile::kMinCalls;
+constexpr int64 ClusterProfile::kMinTFCalls;
+constexpr int64 ClusterProfile::kTFSampleInterval;
+constexpr int64 ClusterProfile::kSaveInterval;
+std::mutex ClusterProfile::s_mutex;
+
+double ClusterProfile::Entry::OVCallUs() const {
+  if (calls == 0) return 0;
+  return static_cast<double>(execute_us + boundary_us + compile_us) / calls;
+}
+
+double ClusterProfile::Entry::TFCallUs() const {
+  if (tf_calls == 0) return 0;
+  return static_cast<double>(tf_us) / tf_calls;
+}
+
+std::string ClusterProfile::Entry::DebugString() const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(1) << "calls " << calls;
+  if (calls > 0) {
+    oss << ", execute " << static_cast<double>(execute_us) / calls
+        << " us, boundary " << static_cast<double>(boundary_us) / calls
+        << " us";
+  }
+  oss << ", compiles " << compiles << " in " << compile_us / 1000 << " ms";
+  if (calls > 0) oss << ", OpenVINO " << OVCallUs() << " us/call";
+  oss << ", TF calls " << tf_calls;
+  if (tf_calls > 0) oss << ", TF " << TFCallUs() << " us/call";
+  return oss.str();
+}
+
+ClusterProfile::State& ClusterProfile::GetState() {
+  static State* state = new State();
+  return *state;
+}
+
+// Reads OPENVINO_TF_CLUSTER_PROFILE and loads the file unless a path was set
+// through SetPath. Requires s_mutex.
+void ClusterProfile::InitLocked(State& state) {
+  if (state.initialized) return;
+  state.initialized = true;
+  state.path = util::GetEnv("OPENVINO_TF_CLUSTER_PROFILE");
+  LoadLocked(state);
+}
+
+// Each line of the file holds the hexadecimal fingerprint of a cluster and
+// the totals of its entry. Lines starting with '#' are comments. Requires
+// s_mutex.
+void ClusterProfile::LoadLocked(State& state) {
+  state.entries.clear();
+  if (state.path.empty()) return;
+  std::ifstream file(state.path);
+  if (!file) {
+    OVTF_VLOG(1) << "No cluster profile found at " << state.path;
+    return;
+  }
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream iss(line);
+    uint64 fingerprint;
+    Entry entry;
+    if (!(iss >> std::hex >> fingerprint >> std::dec >> entry.calls >>
+          entry.execute_us >> entry.boundary_us >> entry.tf_calls >>
+          entry.tf_us >> entry.compiles >> entry.compile_us)) {
+      OVTF_VLOG(1) << "Skipping malformed cluster profile line: " << line;
+      continue;
+    }
+    state.entries[fingerprint] = entry;
+  }
+  OVTF_VLOG(1) << "Loaded the profile of " << state.entries.size()
+               << " clusters from " << state.path;
+}
+
+bool ClusterProfile::IsEnabled() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLocked(state);
+  return !state.path.empty();
+}
+
+uint64 ClusterProfile::Fingerprint(std::vector<std::string> node_names) {
+  std::sort(node_names.begin(), node_names.end());
+  uint64 fingerprint = 0;
+  for (const auto& name : node_names) {
+    fingerprint = Hash64Combine(fingerprint, Hash64(name));
+  }
+  return fingerprint;
+}
+
+// Requires s_mutex, which is released if the entries are saved
+void ClusterProfile::RecordedLocked(std::unique_lock<std::mutex>& lock) {
+  State& state = GetState();
+  if (!state.save_at_exit) {
+    state.save_at_exit = true;
+    std::atexit(SaveAtExit);
+  }
+  if (++state.records_since_save < kSaveInterval) return;
+  state.records_since_save = 0;
+  Status status = SaveUnlocked(lock);
+  if (!status.ok()) {
+    OVTF_VLOG(0) << status.error_message();
+  }
+}
+
+void ClusterProfile::RecordExecution(uint64 fingerprint, int64 execute_us,
+                                     int64 boundary_us) {
+  std::unique_lock<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLocked(state);
+  if (state.path.empty()) return;
+  Entry& entry = state.entries[fingerprint];
+  entry.calls++;
+  entry.execute_us += execute_us;
+  entry.boundary_us += boundary_us;
+  RecordedLocked(lock);
+}
+
+void ClusterProfile::RecordTF(uint64 fingerprint, int64 tf_us) {
+  std::unique_lock<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLocked(state);
+  if (state.path.empty()) return;
+  Entry& entry = state.entries[fingerprint];
+  entry.tf_calls++;
+  entry.tf_us += tf_us;
+  RecordedLocked(lock);
+}
+
+void ClusterProfile::RecordCompile(uint64 fingerprint, int64 compile_us) {
+  std::unique_lock<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLocked(state);
+  if (state.path.empty()) return;
+  Entry& entry = state.entries[fingerprint];
+  entry.compiles++;
+  entry.compile_us += compile_us;
+  RecordedLocked(lock);
+}
+
+bool ClusterProfile::Lookup(uint64 fingerprint, Entry& entry) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLocked(state);
+  auto it = state.entries.find(fingerprint);
+  if (it == state.entries.end()) return false;
+  entry = it->second;
+  return true;
+}
+
+Status ClusterProfile::Save() {
+  std::unique_lock<std::mutex> lock(s_mutex);
+  InitLocked(GetState());
+  return SaveUnlocked(lock);
+}
+
+Status ClusterProfile::SaveUnlocked(std::unique_lock<std::mutex>& lock) {
+  State& state = GetState();
+  if (state.path.empty()) return Status::OK();
+  std::string path = state.path;
+  auto entries = state.entries;
+  lock.unlock();
+  return Write(path, entries);
+}
+
+// Writes a temporary file first so that readers never see a partial profile
+Status ClusterProfile::Write(const std::string& path,
+                             const std::unordered_map<uint64, Entry>& entries) {
+  // Periodic saves of different threads share the temporary file
+  static std::mutex write_mutex;
+  std::lock_guard<std::mutex> write_lock(write_mutex);
+  std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    if (!file) {
+      return errors::Internal("Cannot write the cluster profile ", tmp_path);
+    }
+    file << "# fingerprint calls execute_us boundary_us tf_calls tf_us "
+            "compiles compile_us\n";
+    for (const auto& kv : entries) {
+      const Entry& entry = kv.second;
+      file << std::hex << kv.first << std::dec << " " << entry.calls << " "
+           << entry.execute_us << " " << entry.boundary_us << " "
+           << entry.tf_calls << " " << entry.tf_us << " " << entry.compiles
+           << " " << entry.compile_us << "\n";
+    }
+    if (!file) {
+      return errors::Internal("Cannot write the cluster profile ", tmp_path);
+    }
+  }
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return errors::Internal("Cannot replace the cluster profile ", path);
+  }
+  OVTF_VLOG(1) << "Saved the profile of " << entries.size()
+               << " clusters to " << path;
+  return Status::OK();
+}
+
+void ClusterProfile::SaveAtExit() {
+  Status status = Save();
+  if (!status.ok()) {
+    OVTF_VLOG(0) << status.error_message();
+  }
+}
+
+void ClusterProfile::SetPath(const std::string& path) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  state.initialized = true;
+  state.path = path;
+  state.records_since_save = 0;
+  LoadLocked(state);
+}
+
+void ClusterProfile::Clear() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  state.entries.clear();
+  state.records_since_save = 0;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
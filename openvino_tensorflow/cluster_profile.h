@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CLUSTER_PROFILE_H_
+#define OPENVINO_TF_CLUSTER_PROFILE_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Runtime measurements of the clusters, kept across processes in the file
+// named by OPENVINO_TF_CLUSTER_PROFILE. The encapsulate kernels record the
+// time of their calls on OpenVINO, of the calls run by native TF, and of
+// their compilations. The next rewrite of the same graph reads them back to
+// deassign the clusters that turned out slower than TF.
+//
+// Cluster ids change between processes, so the entries are keyed by a
+// fingerprint of the names of the nodes of the cluster. The totals loaded
+// from the file are accumulated with the new measurements, and the file is
+// rewritten every kSaveInterval records and at exit.
+class ClusterProfile {
+ public:
+  // Measurements needed on both OpenVINO and TF before a cluster is judged
+  static constexpr int64 kMinCalls = 10;
+  static constexpr int64 kMinTFCalls = 3;
+  // Until a cluster has kMinTFCalls TF measurements, one call out of
+  // kTFSampleInterval runs on native TF
+  static constexpr int64 kTFSampleInterval = 10;
+  static constexpr int64 kSaveInterval = 1000;
+
+  // Totals of a cluster, times in microseconds
+  struct Entry {
+    // Calls run with OpenVINO, the time of their inference and the time
+    // spent wrapping the inputs and handing the outputs over to TF
+    int64 calls = 0;
+    int64 execute_us = 0;
+    int64 boundary_us = 0;
+    // Calls run by native TF
+    int64 tf_calls = 0;
+    int64 tf_us = 0;
+    int64 compiles = 0;
+    int64 compile_us = 0;
+
+    bool HasMeasurements() const {
+      return calls >= kMinCalls && tf_calls >= kMinTFCalls;
+    }
+    // Mean time of a call on OpenVINO, with the compilations amortized over
+    // the calls
+    double OVCallUs() const;
+    double TFCallUs() const;
+    bool SlowerThanTF() const {
+      return HasMeasurements() && OVCallUs() > TFCallUs();
+    }
+    // Whether the copies at the cluster boundary took longer than the
+    // inference itself
+    bool BoundaryDominated() const {
+      return calls > 0 && boundary_us > execute_us;
+    }
+    std::string DebugString() const;
+  };
+
+  static bool IsEnabled();
+  // Order-independent fingerprint of the node names of a cluster
+  static uint64 Fingerprint(std::vector<std::string> node_names);
+
+  static void RecordExecution(uint64 fingerprint, int64 execute_us,
+                              int64 boundary_us);
+  static void RecordTF(uint64 fingerprint, int64 tf_us);
+  static void RecordCompile(uint64 fingerprint, int64 compile_us);
+  // Returns false if nothing was recorded for the cluster
+  static bool Lookup(uint64 fingerprint, Entry& entry);
+
+  // Writes all entries to the profile file
+  static Status Save();
+  // Switches to another profile file and loads it, disables the profile if
+  // the path is empty
+  static void SetPath(const std::string& path);
+  // Forgets all entries without touching the file
+  static void Clear();
+
+ private:
+  struct State {
+    std::string path;
+    bool initialized = false;
+    std::unordered_map<uint64, Entry> entries;
+    int64 records_since_save = 0;
+    bool save_at_exit = false;
+  };
+
+  // The state is never destroyed, so it is still valid when saved at exit
+  static State& GetState();
+  static void InitLocked(State& state);
+  static void LoadLocked(State& state);
+  // Counts a record, and saves the entries every kSaveInterval records
+  static void RecordedLocked(std::unique_lock<std::mutex>& lock);
+  // Copies the entries under the held lock, and writes them once released
+  static Status SaveUnlocked(std::unique_lock<std::mutex>& lock);
+  static Status Write(const std::string& path,
+                      const std::unordered_map<uint64, Entry>& entries);
+  static void SaveAtExit();
+
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CLUSTER_PROFILE_H_
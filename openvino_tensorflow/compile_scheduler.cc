@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/compile_scheduler.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+namespace {
+
+size_t GetEnvSize(const char* name, size_t default_value) {
+  const char* value = std::getenv(name);
+  if (value == nullptr) return default_value;
+  long parsed = strtol(value, nullptr, 10);
+  return parsed > 0 ? static_cast<size_t>(parsed) : default_value;
+}
+
+}  // namespace
+
+CompileScheduler& CompileScheduler::Get() {
+  // Never destroyed, the workers may still be waiting for jobs at exit
+  static CompileScheduler* scheduler = new CompileScheduler();
+  return *scheduler;
+}
+
+bool CompileScheduler::IsBackgroundCompileEnabled() {
+  const char* enabled = std::getenv("OPENVINO_TF_BACKGROUND_COMPILE");
+  return enabled != nullptr && std::string(enabled) == "1";
+}
+
+CompileScheduler::CompileScheduler()
+    : m_num_workers(GetEnvSize(
+          "OPENVINO_TF_COMPILE_THREADS",
+          std::max<size_t>(1, std::min<size_t>(
+                                  4, std::thread::hardware_concurrency())))),
+      m_max_queue_size(GetEnvSize("OPENVINO_TF_COMPILE_QUEUE_SIZE", 32)),
+      m_memory_limit_kb(
+          GetEnvSize("OPENVINO_TF_COMPILE_MEMORY_LIMIT", 0) * 1024) {}
+
+CompileScheduler::SubmitResult CompileScheduler::Submit(
+    const void* owner, const std::string& key, std::function<Status()> job) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_in_flight.count(key)) return SubmitResult::kInFlight;
+  if (m_queue.size() >= m_max_queue_size) {
+    OVTF_VLOG(1) << "Compile queue is full, dropping job";
+    m_progress.dropped++;
+    return SubmitResult::kQueueFull;
+  }
+  // Start the workers on first use
+  while (m_workers.size() < m_num_workers) {
+    m_workers.emplace_back(&CompileScheduler::WorkerLoop, this);
+  }
+  m_in_flight[key] = owner;
+  m_queue.push_back({owner, key, std::move(job)});
+  m_progress.queued++;
+  m_job_available.notify_one();
+  return SubmitResult::kQueued;
+}
+
+bool CompileScheduler::IsInFlight(const std::string& key) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_in_flight.count(key) != 0;
+}
+
+void CompileScheduler::Wait(const std::string& key) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_job_finished.wait(lock,
+                      [this, &key]() { return m_in_flight.count(key) == 0; });
+}
+
+void CompileScheduler::Drain(const void* owner) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (auto it = m_queue.begin(); it != m_queue.end();) {
+    if (it->owner == owner) {
+      m_in_flight.erase(it->key);
+      m_progress.queued--;
+      m_progress.dropped++;
+      it = m_queue.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  // Wake up the waiters of the dropped jobs
+  m_job_finished.notify_all();
+  m_job_finished.wait(lock, [this, owner]() {
+    return std::none_of(
+        m_in_flight.begin(), m_in_flight.end(),
+        [owner](const std::pair<const std::string, const void*>& job) {
+          return job.second == owner;
+        });
+  });
+}
+
+CompileScheduler::Progress CompileScheduler::GetProgress() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_progress;
+}
+
+bool CompileScheduler::CanStartJobLocked() {
+  if (m_memory_limit_kb == 0 || m_progress.running == 0) return true;
+  long vm = 0, rss = 0;
+  util::MemoryProfile(vm, rss);
+  return rss + m_job_memory_kb <= m_memory_limit_kb;
+}
+
+void CompileScheduler::WorkerLoop() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_job_available.wait(lock, [this]() {
+        return !m_queue.empty() && CanStartJobLocked();
+      });
+      job = std::move(m_queue.front());
+      m_queue.pop_front();
+      m_progress.queued--;
+      m_progress.running++;
+    }
+    long vm0 = 0, rss0 = 0;
+    util::MemoryProfile(vm0, rss0);
+    Status status;
+    try {
+      status = job.run();
+    } catch (const std::exception& e) {
+      status = errors::Internal(e.what());
+    } catch (...) {
+      status = errors::Internal("Unknown exception");
+    }
+    if (!status.ok()) {
+      OVTF_VLOG(0) << "Compile job failed: " << status.error_message();
+    }
+    long vm = 0, rss = 0;
+    util::MemoryProfile(vm, rss);
+    // Release whatever the job captured before it is reported as finished
+    job.run = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_in_flight.erase(job.key);
+      m_progress.running--;
+      if (status.ok()) {
+        m_progress.completed++;
+      } else {
+        m_progress.failed++;
+      }
+      long job_memory_kb = std::max(rss - rss0, 0L);
+      m_job_memory_kb = m_job_memory_kb == 0
+                            ? job_memory_kb
+                            : (3 * m_job_memory_kb + job_memory_kb) / 4;
+    }
+    m_job_finished.notify_all();
+    // Jobs held back by the memory limit may start now
+    m_job_available.notify_all();
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
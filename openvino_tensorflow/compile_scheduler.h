@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_COMPILE_SCHEDULER_H_
+#define OPENVINO_TF_COMPILE_SCHEDULER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Runs translation and compilation jobs on a small pool of worker threads.
+// The queue is bounded and jobs are deduplicated by key, so concurrent cache
+// misses for the same cluster and signature compile only once.
+//
+// The number of workers is set by OPENVINO_TF_COMPILE_THREADS (default up to
+// 4, bounded by the number of cores) and the queue length by
+// OPENVINO_TF_COMPILE_QUEUE_SIZE (default 32). With
+// OPENVINO_TF_COMPILE_MEMORY_LIMIT (in MB), a job only starts while another
+// one is running if the resident memory of the process leaves room for the
+// average memory growth of the past jobs.
+class CompileScheduler {
+ public:
+  enum class SubmitResult { kQueued, kInFlight, kQueueFull };
+
+  // Job counts since the start of the process
+  struct Progress {
+    int64_t queued = 0;
+    int64_t running = 0;
+    int64_t completed = 0;
+    int64_t failed = 0;
+    // Jobs rejected by a full queue or dropped before they ran
+    int64_t dropped = 0;
+  };
+
+  static CompileScheduler& Get();
+
+  // Returns true if OPENVINO_TF_BACKGROUND_COMPILE enables serving cache
+  // misses on native TF while the executable compiles
+  static bool IsBackgroundCompileEnabled();
+
+  // Queues a job unless a job with the same key is queued or running. The
+  // owner identifies the jobs to drop in Drain.
+  SubmitResult Submit(const void* owner, const std::string& key,
+                      std::function<Status()> job);
+  bool IsInFlight(const std::string& key);
+  // Waits until the job with the key is neither queued nor running
+  void Wait(const std::string& key);
+  // Drops the queued jobs of the owner and waits for its running ones
+  void Drain(const void* owner);
+  Progress GetProgress();
+
+ private:
+  struct Job {
+    const void* owner;
+    std::string key;
+    std::function<Status()> run;
+  };
+
+  CompileScheduler();
+  void WorkerLoop();
+  // Checks the memory limit before a job starts. Requires m_mutex.
+  bool CanStartJobLocked();
+
+  std::mutex m_mutex;
+  std::condition_variable m_job_available;
+  std::condition_variable m_job_finished;
+  std::deque<Job> m_queue;
+  // Keys of the queued and running jobs, mapped to their owners
+  std::unordered_map<std::string, const void*> m_in_flight;
+  std::vector<std::thread> m_workers;
+  size_t m_num_workers;
+  size_t m_max_queue_size;
+  // 0 if the memory taken by compilations is not limited
+  long m_memory_limit_kb;
+  // Moving average of the resident memory growth of a job
+  long m_job_memory_kb = 0;
+  Progress m_progress;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_COMPILE_SCHEDULER_H_
@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <cstring>
+
+#include "tensorflow/core/lib/hash/hash.h"
+
+#include "ngraph/runtime/shared_buffer.hpp"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/constant_pool.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+constexpr size_t ConstantPool::kMinPooledBytes;
+std::mutex ConstantPool::s_mutex;
+
+ConstantPool::State& ConstantPool::GetState() {
+  static State* state = new State();
+  return *state;
+}
+
+bool ConstantPool::IsEnabled() {
+  static const bool enabled =
+      util::GetEnv("OPENVINO_TF_DISABLE_CONSTANT_POOL") != "1";
+  return enabled;
+}
+
+std::shared_ptr<ov::Node> ConstantPool::MakeConstant(
+    const ov::element::Type& type, const ov::Shape& shape, const void* data,
+    size_t size_bytes) {
+  if (!IsEnabled() || size_bytes < kMinPooledBytes ||
+      size_bytes != ov::shape_size(shape) * type.size()) {
+    return nullptr;
+  }
+
+  // Hashing large weights takes a while, so it is done without the lock
+  uint64 hash = Hash64(static_cast<const char*>(data), size_bytes);
+  std::shared_ptr<Buffer> buffer;
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    buffer = GetBufferLocked(GetState(), hash, type, shape, data, size_bytes);
+  }
+
+  // The Constant keeps the pooled buffer alive without copying it
+  using SharedBuffer = ngraph::runtime::SharedBuffer<std::shared_ptr<Buffer>>;
+  auto shared = make_shared<SharedBuffer>(
+      static_cast<char*>(buffer->get_ptr()), size_bytes, buffer);
+  return make_shared<opset::Constant>(type, shape, shared);
+}
+
+// Returns the pooled buffer holding the data, adding a copy of it to the
+// pool if there is none yet. Requires s_mutex.
+std::shared_ptr<ConstantPool::Buffer> ConstantPool::GetBufferLocked(
+    State& state, uint64 hash, const ov::element::Type& type,
+    const ov::Shape& shape, const void* data, size_t size_bytes) {
+  auto range = state.entries.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    auto buffer = it->second.buffer.lock();
+    if (buffer && it->second.type == type && it->second.shape == shape &&
+        buffer->size() == size_bytes &&
+        memcmp(buffer->get_ptr(), data, size_bytes) == 0) {
+      state.hits++;
+      state.shared_bytes += size_bytes;
+      OVTF_VLOG(2) << "Sharing pooled constant of " << size_bytes / 1024
+                   << " KB";
+      return buffer;
+    }
+  }
+
+  if (state.entries.size() >= state.prune_threshold) {
+    PruneLocked(state);
+    state.prune_threshold = std::max<size_t>(1024, 2 * state.entries.size());
+  }
+  auto buffer = make_shared<Buffer>(size_bytes);
+  memcpy(buffer->get_ptr(), data, size_bytes);
+  state.entries.emplace(hash, Entry{type, shape, buffer});
+  return buffer;
+}
+
+// Drops the entries whose buffers were released by all models. Requires
+// s_mutex.
+void ConstantPool::PruneLocked(State& state) {
+  for (auto it = state.entries.begin(); it != state.entries.end();) {
+    if (it->second.buffer.expired()) {
+      it = state.entries.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+ConstantPool::Stats ConstantPool::GetStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  Stats stats;
+  for (auto& entry : state.entries) {
+    auto buffer = entry.second.buffer.lock();
+    if (!buffer) continue;
+    stats.num_buffers++;
+    stats.size_bytes += buffer->size();
+  }
+  stats.hits = state.hits;
+  stats.shared_bytes = state.shared_bytes;
+  return stats;
+}
+
+void ConstantPool::Clear() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  state.entries.clear();
+  state.hits = 0;
+  state.shared_bytes = 0;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
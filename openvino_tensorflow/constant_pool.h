@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_CONSTANT_POOL_H_
+#define OPENVINO_TF_CONSTANT_POOL_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "tensorflow/core/platform/types.h"
+
+#include "ngraph/runtime/aligned_buffer.hpp"
+#include "openvino/core/node.hpp"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Process-wide pool of the data of the constants of translated models.
+// Constants with the same element type, shape and bytes share one immutable
+// buffer, so the executables that are compiled for the different input
+// shapes of a cluster, and clusters that use the same weights, hold a
+// single copy of them.
+//
+// The pool only references its buffers weakly: a buffer is released with
+// the last model that uses it. Pooling is enabled unless
+// OPENVINO_TF_DISABLE_CONSTANT_POOL is set to 1.
+class ConstantPool {
+ public:
+  // Smaller constants are not worth the hashing
+  static constexpr size_t kMinPooledBytes = 1024;
+
+  struct Stats {
+    // Buffers that are alive and their total size
+    int64 num_buffers = 0;
+    int64 size_bytes = 0;
+    // Constants that reused a pooled buffer and the bytes this saved
+    int64 hits = 0;
+    int64 shared_bytes = 0;
+  };
+
+  // Returns a Constant of the type and shape holding a copy of the
+  // size_bytes at data, or the pooled copy of identical data. Returns nullptr
+  // if pooling is disabled, the data is smaller than 1 KB or size_bytes does
+  // not match the type and shape, so the caller builds a plain Constant.
+  static std::shared_ptr<ov::Node> MakeConstant(const ov::element::Type& type,
+                                                const ov::Shape& shape,
+                                                const void* data,
+                                                size_t size_bytes);
+  static bool IsEnabled();
+  static Stats GetStats();
+  // Forgets all pooled buffers. Models keep the buffers they reference.
+  static void Clear();
+
+ private:
+  using Buffer = ngraph::runtime::AlignedBuffer;
+  struct Entry {
+    ov::element::Type type;
+    ov::Shape shape;
+    std::weak_ptr<Buffer> buffer;
+  };
+  struct State {
+    // Entries by the hash of their data. Colliding entries are told apart by
+    // comparing their type, shape and bytes.
+    std::unordered_multimap<uint64, Entry> entries;
+    int64 hits = 0;
+    int64 shared_bytes = 0;
+    // Released entries are pruned when the pool grows beyond this size
+    size_t prune_threshold = 1024;
+  };
+
+  static State& GetState();
+  static std::shared_ptr<Buffer> GetBufferLocked(State& state, uint64 hash,
+                                                 const ov::element::Type& type,
+                                                 const ov::Shape& shape,
+                                                 const void* data,
+                                                 size_t size_bytes);
+  static void PruneLocked(State& state);
+
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_CONSTANT_POOL_H_
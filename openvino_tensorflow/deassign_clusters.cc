@@ -6,6 +6,9 @@
 #include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <unordered_map>
 
@@ -21,9 +24,13 @@
 #include "logging/ovtf_log.h"
 #include "openvino_tensorflow/assign_clusters.h"
 #include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/cluster_cost_model.h"
+#include "openvino_tensorflow/cluster_profile.h"
 #include "openvino_tensorflow/deassign_clusters.h"
+#include "openvino_tensorflow/graph_shapes.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/tf_deadness_analysis.h"
 
 using namespace std;
 
@@ -34,15 +41,20 @@ namespace openvino_tensorflow {
 // The clustering pass of assign_clusters.cc sometimes generates many
 // small, trivial clusters. In this pass, we simply deassign (i.e., remove the
 // _ovtf_cluster and _ovtf_marked_for_clustering attributes) any such
-// trivial clusters. For now, "trivial" just means that there are not at least
-// two non-trivial ops in the graph, where a "trivial op" means "Const" or
-// "Identity".
+// trivial clusters. A cluster is trivial when the ClusterCostModel predicts
+// that running it on OpenVINO does not pay for the encapsulate call and the
+// transfer of its inputs and outputs. If OPENVINO_TF_MIN_NONTRIVIAL_NODES is
+// set, a cluster is trivial when it has fewer ops than that, not counting
+// "Const" ops. With OPENVINO_TF_CLUSTER_PROFILE, clusters that earlier runs
+// measured to be slower than native TF are deassigned as well.
 //
 // For unit testing purposes, this pass can be bypassed by setting
 // OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS=1.
 //
 
 unordered_map<string, int> deassigned_histogram;
+// Why each cluster was kept or busted for its size
+std::map<int, string> cluster_decisions;
 int num_nodes_marked_before_deassign = 0;
 
 static void MaybeLogPlacement(const Graph* graph) {
@@ -136,6 +148,11 @@ static void MaybeLogPlacement(const Graph* graph) {
   std::cout << "OVTF_SUMMARY: Op_deassigned: ";
   util::PrintNodeHistogram(deassigned_histogram);
 
+  for (auto& kv : cluster_decisions) {
+    std::cout << "OVTF_SUMMARY: Cluster decision [" << kv.first
+              << "]: " << kv.second << std::endl;
+  }
+
   for (auto kv : final_cluster_map) {
     int cluster_idx = kv.first;
     std::set<const Node*>& nodes = kv.second;
@@ -154,13 +171,200 @@ static void MaybeLogPlacement(const Graph* graph) {
   std::cout << endl;
 }
 
-Status DeassignClusters(Graph* graph) {
+// Two clusters can end up separated by a single pass-through op that was left
+// out of both, for example when deassignment busted the trivial cluster of
+// the op. The tensor then leaves OpenVINO only to be handed back unchanged.
+// Such a pass-through op is fused with the clusters on both sides when all
+// its inputs come from one cluster and all its outputs go to one cluster,
+// and the merged cluster is still a valid one: same device, no deadness,
+// no static input fed from the other side, and no path between the two
+// clusters that leaves them.
+static Status FusePassThroughClusters(Graph* graph) {
+  static const std::set<std::string> pass_through_ops = {"Identity",
+                                                         "Snapshot"};
+  std::map<int, std::set<Node*>> cluster_map;
+  std::vector<Node*> candidates;
+  for (auto node : graph->op_nodes()) {
+    int cluster_idx;
+    if (GetNodeCluster(node, &cluster_idx) == Status::OK()) {
+      cluster_map[cluster_idx].insert(node);
+    } else if (pass_through_ops.count(node->type_string()) &&
+               node->num_inputs() == 1) {
+      candidates.push_back(node);
+    }
+  }
+  if (candidates.empty() || cluster_map.empty()) return Status::OK();
+
+  std::unique_ptr<DeadnessAnalysis> deadness_analyzer;
+  TF_RETURN_IF_ERROR(DeadnessAnalysis::Run(*graph, &deadness_analyzer));
+  auto has_true_pred = [&deadness_analyzer](const Node* node) {
+    DeadnessAnalysis::PredicateHandle pred;
+    return deadness_analyzer->GetNodePredicate(*node, pred) == Status::OK() &&
+           deadness_analyzer->IsTruePredicate(pred);
+  };
+  // Clusters whose nodes all have the True predicate
+  std::map<int, bool> cluster_without_deadness;
+  auto is_without_deadness = [&](int cluster_idx) {
+    auto it = cluster_without_deadness.find(cluster_idx);
+    if (it != cluster_without_deadness.end()) return it->second;
+    bool result = true;
+    for (auto node : cluster_map[cluster_idx]) {
+      if (!has_true_pred(node)) {
+        result = false;
+        break;
+      }
+    }
+    cluster_without_deadness[cluster_idx] = result;
+    return result;
+  };
+
+  for (auto node : candidates) {
+    int src_cluster = -1;
+    int dst_cluster = -1;
+    Node* src = nullptr;
+    bool fusable = true;
+    for (auto edge : node->in_edges()) {
+      if (edge->IsControlEdge() ||
+          GetNodeCluster(edge->src(), &src_cluster) != Status::OK()) {
+        fusable = false;
+        break;
+      }
+      src = edge->src();
+    }
+    for (auto edge : node->out_edges()) {
+      if (!fusable) break;
+      int out_cluster;
+      if (edge->IsControlEdge() ||
+          GetNodeCluster(edge->dst(), &out_cluster) != Status::OK() ||
+          (dst_cluster != -1 && out_cluster != dst_cluster)) {
+        fusable = false;
+      }
+      dst_cluster = out_cluster;
+    }
+    if (!fusable || src == nullptr || dst_cluster == -1 ||
+        node->assigned_device_name() != src->assigned_device_name() ||
+        !has_true_pred(node) || !is_without_deadness(src_cluster) ||
+        !is_without_deadness(dst_cluster)) {
+      continue;
+    }
+
+    std::set<Node*>& src_nodes = cluster_map[src_cluster];
+    std::set<Node*>& dst_nodes = cluster_map[dst_cluster];
+    if (src_cluster != dst_cluster) {
+      // Static inputs are computed by TF before the cluster runs
+      bool static_input_from_src = false;
+      for (auto dst_node : dst_nodes) {
+        std::vector<int32> static_inputs;
+        GetStaticInputs(dst_node, &static_inputs);
+        for (auto index : static_inputs) {
+          const Edge* edge;
+          TF_RETURN_IF_ERROR(dst_node->input_edge(index, &edge));
+          if (edge->src() == node || (src_nodes.count(edge->src()) &&
+                                      edge->src()->type_string() != "Const")) {
+            static_input_from_src = true;
+          }
+        }
+      }
+      if (static_input_from_src) continue;
+
+      // Any path from the source cluster to the destination cluster through
+      // other nodes would become a cycle
+      std::vector<Node*> stack;
+      std::set<Node*> visited;
+      for (auto src_node : src_nodes) {
+        for (auto edge : src_node->out_edges()) {
+          Node* out = edge->dst();
+          if (out->IsOp() && out != node && !src_nodes.count(out) &&
+              !dst_nodes.count(out) && visited.insert(out).second) {
+            stack.push_back(out);
+          }
+        }
+      }
+      bool creates_cycle = false;
+      while (!stack.empty() && !creates_cycle) {
+        Node* current = stack.back();
+        stack.pop_back();
+        if (current->IsNextIteration()) continue;
+        for (auto out : current->out_nodes()) {
+          if (dst_nodes.count(out)) {
+            creates_cycle = true;
+            break;
+          }
+          if (out->IsOp() && visited.insert(out).second) {
+            stack.push_back(out);
+          }
+        }
+      }
+      if (creates_cycle) continue;
+    }
+
+    OVTF_VLOG(2) << "Fusing clusters " << src_cluster << " and "
+                 << dst_cluster << " through " << node->name() << " ["
+                 << node->type_string() << "]";
+    node->AddAttr("_ovtf_marked_for_clustering", true);
+    node->AddAttr("_ovtf_cluster", src_cluster);
+    src_nodes.insert(node);
+    if (src_cluster != dst_cluster) {
+      for (auto dst_node : dst_nodes) {
+        dst_node->AddAttr("_ovtf_cluster", src_cluster);
+        src_nodes.insert(dst_node);
+      }
+      cluster_map.erase(dst_cluster);
+      cluster_without_deadness.erase(dst_cluster);
+    }
+  }
+  return Status::OK();
+}
+
+// Deassigns the clusters that the cluster profile measured to be slower than
+// native TF, compilations included. The profile is keyed by the nodes of the
+// clusters as they are encapsulated, so it is applied to the final clusters.
+static void ApplyClusterProfile(Graph* graph) {
+  std::map<int, std::vector<Node*>> cluster_map;
+  for (auto node : graph->op_nodes()) {
+    int cluster_idx;
+    if (GetNodeCluster(node, &cluster_idx) == Status::OK()) {
+      cluster_map[cluster_idx].push_back(node);
+    }
+  }
+
+  for (auto& kv : cluster_map) {
+    int cluster_idx = kv.first;
+    std::vector<std::string> node_names;
+    for (auto node : kv.second) node_names.push_back(node->name());
+    ClusterProfile::Entry entry;
+    if (!ClusterProfile::Lookup(ClusterProfile::Fingerprint(node_names),
+                                entry)) {
+      continue;
+    }
+    std::string profile = "profiled " + entry.DebugString();
+    if (entry.BoundaryDominated()) profile += ", boundary copies dominate";
+
+    if (!entry.SlowerThanTF()) {
+      cluster_decisions[cluster_idx] += "; " + profile;
+      continue;
+    }
+    cluster_decisions[cluster_idx] = "busted: " + profile;
+    OVTF_VLOG(1) << "Cluster " << cluster_idx << " "
+                 << cluster_decisions[cluster_idx];
+    for (auto node : kv.second) {
+      OVTF_VLOG(2) << "Busting node: " << node->name() << " ["
+                   << node->type_string() << "]";
+      node->ClearAttr("_ovtf_cluster");
+      node->ClearAttr("_ovtf_marked_for_clustering");
+      deassigned_histogram[node->type_string()]++;
+    }
+  }
+}
+
+Status DeassignClusters(Graph* graph, const GraphShapes* shapes) {
   //
   // When running unit tests, we do not want to see trivial clusters
   // deassigned. This flag (used by the Python tests) makes this possible.
   //
   num_nodes_marked_before_deassign = 0;  // reset for every TF graph
   deassigned_histogram.clear();          // reset the histogram
+  cluster_decisions.clear();
 
   if (std::getenv("OPENVINO_TF_DISABLE_DEASSIGN_CLUSTERS") != nullptr) {
     // still need to calculate num_nodes_marked_before_deassign
@@ -193,6 +397,11 @@ Status DeassignClusters(Graph* graph) {
     throw runtime_error(exec_status.error_message());
   }
 
+  // Built on the first cluster it has to score, with the shapes inferred by
+  // the caller if it passed them
+  std::unique_ptr<GraphShapes> own_shapes;
+  std::unique_ptr<ClusterCostModel> cost_model;
+
   std::vector<int> alive_clusters;
   int max_cluster_size = 0;
   int max_cluster_idx = -1;
@@ -201,31 +410,44 @@ Status DeassignClusters(Graph* graph) {
     int cluster_idx = kv.first;
     std::set<Node*>& nodes = kv.second;
 
-    int non_trivial_count = 0;
+    bool bust_cluster;
+    std::string decision;
+    if (std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES") != nullptr) {
+      // A minimum node count replaces the cost model
+      int non_trivial_count = 0;
 
-    std::unordered_set<std::string> trivial_ops = {"Const", "Identitiy"};
-    for (auto node : nodes) {
-      if (trivial_ops.find(node->type_string()) == trivial_ops.end()) {
-        non_trivial_count++;
+      std::unordered_set<std::string> trivial_ops = {"Const", "Identitiy"};
+      for (auto node : nodes) {
+        if (trivial_ops.find(node->type_string()) == trivial_ops.end()) {
+          non_trivial_count++;
+        }
       }
-    }
 
-    int min_non_trivial_nodes = num_nodes_marked_before_deassign >> 6;
-    int avg_nodes_marked_before_deassign =
-        num_nodes_marked_before_deassign / cluster_map.size();
-    if (min_non_trivial_nodes < avg_nodes_marked_before_deassign * 2) {
-      min_non_trivial_nodes >>= 2;
-    }
-    if (min_non_trivial_nodes < 6) {
-      min_non_trivial_nodes = 6;
-    }
-    if (std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES") != nullptr) {
-      min_non_trivial_nodes =
+      int min_non_trivial_nodes =
           std::stoi(std::getenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES"));
+      OVTF_VLOG(1) << "MIN_NONTRIVIAL_NODES set to " << min_non_trivial_nodes;
+      bust_cluster = non_trivial_count < min_non_trivial_nodes;
+      decision = std::to_string(non_trivial_count) +
+                 " non-trivial nodes, minimum " +
+                 std::to_string(min_non_trivial_nodes);
+    } else {
+      if (cost_model == nullptr) {
+        if (shapes == nullptr) {
+          own_shapes.reset(new GraphShapes(*graph));
+          shapes = own_shapes.get();
+        }
+        cost_model.reset(new ClusterCostModel(graph, *shapes, device));
+      }
+      auto estimate = cost_model->EstimateCluster(nodes);
+      bust_cluster = estimate.Gain() <= 0;
+      decision = estimate.DebugString();
     }
-    OVTF_VLOG(1) << "MIN_NONTRIVIAL_NODES set to " << min_non_trivial_nodes;
+    cluster_decisions[cluster_idx] =
+        (bust_cluster ? "busted: " : "kept: ") + decision;
+    OVTF_VLOG(1) << "Cluster " << cluster_idx << " "
+                 << cluster_decisions[cluster_idx];
 
-    if (non_trivial_count < min_non_trivial_nodes) {
+    if (bust_cluster) {
       OVTF_VLOG(2) << "Busting cluster " << cluster_idx;
       for (auto node : nodes) {
         OVTF_VLOG(2) << "Busting node: " << node->name() << " ["
@@ -392,6 +614,16 @@ Status DeassignClusters(Graph* graph) {
     }
   }
 
+  // Devices that keep only the largest cluster have nothing to fuse
+  if (device != "HDDL" && device != "MYRIAD" &&
+      std::getenv("OPENVINO_TF_DISABLE_PASSTHROUGH_FUSION") == nullptr) {
+    TF_RETURN_IF_ERROR(FusePassThroughClusters(graph));
+  }
+
+  if (ClusterProfile::IsEnabled()) {
+    ApplyClusterProfile(graph);
+  }
+
   //
   // At this point we have made our final decision about cluster assignment, so
   // we will log the cluster assignment now.
@@ -10,11 +10,15 @@
 
 #include "tensorflow/core/graph/graph.h"
 
+#include "openvino_tensorflow/graph_shapes.h"
+
 namespace tensorflow {
 
 namespace openvino_tensorflow {
 
-Status DeassignClusters(Graph* graph);
+// The cost model uses the shapes when given, which must have been inferred
+// on the graph as it is, and otherwise infers them
+Status DeassignClusters(Graph* graph, const GraphShapes* shapes = nullptr);
 
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
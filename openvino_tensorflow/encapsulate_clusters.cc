@@ -38,6 +38,7 @@
 #include "openvino_tensorflow/encapsulate_clusters.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_builder.h"
+#include "openvino_tensorflow/warmup.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 #include "openvino_tensorflow/version.h"
 
@@ -68,7 +69,8 @@ void Encapsulator::AddInput(NodeDef* dst, StringPiece src_name, int src_slot) {
 
 Status EncapsulateClusters(
     Graph* graph, int graph_id,
-    const std::unordered_map<std::string, std::string>& device_config) {
+    const std::unordered_map<std::string, std::string>& device_config,
+    const GraphShapes* shapes) {
   Encapsulator enc(graph);
   OVTF_VLOG(3) << "Running AnalysisPass in EncapsulateClusters";
   TF_RETURN_IF_ERROR(enc.AnalysisPass());
@@ -78,6 +80,20 @@ Status EncapsulateClusters(
   set<int> newly_created_cluster_ids;
   TF_RETURN_IF_ERROR(enc.GetNewClusterIDs(newly_created_cluster_ids));
 
+  // Attach the input shapes declared through api::Warmup, or the ones the
+  // graph fixes, to the encapsulate nodes. Failing to propagate them only
+  // skips the warmup.
+  std::map<Node*, std::vector<PartialTensorShape>> graph_input_shapes;
+  if (shapes != nullptr) {
+    TF_RETURN_IF_ERROR(enc.GetClusterInputShapes(*shapes, graph_input_shapes));
+  }
+  Status warmup_status = WarmupRegistry::AnnotateGraph(
+      graph, shapes != nullptr ? &graph_input_shapes : nullptr);
+  if (!warmup_status.ok()) {
+    OVTF_VLOG(0) << "Failed to propagate the warmup shapes: "
+                 << warmup_status.error_message();
+  }
+
   // Pass 9 (optional, only run if environment variable
   // OPENVINO_TF_DUMP_CLUSTERS is set): validate the graph def, and
   // make sure we can construct a graph from it.
@@ -593,5 +609,27 @@ Status Encapsulator::GetNewClusterIDs(set<int>& result) {
   return Status::OK();
 }
 
+Status Encapsulator::GetClusterInputShapes(
+    const GraphShapes& shapes,
+    std::map<Node*, std::vector<PartialTensorShape>>& result) {
+  if (!rewrite_done) {
+    return errors::Internal(
+        "In Encapsulator, called GetClusterInputShapes without calling "
+        "RewritePass");
+  }
+  result.clear();
+  for (auto& kv : cluster_node_map) {
+    auto& input_shapes = result[kv.second];
+    for (auto& tup : cluster_input_map[kv.first]) {
+      int src_node_id = -1;
+      int src_output_idx = -1;
+      DataType dt;
+      std::tie(src_node_id, src_output_idx, dt) = tup;
+      input_shapes.push_back(shapes.OutputShape(src_node_id, src_output_idx));
+    }
+  }
+  return Status::OK();
+}
+
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -14,8 +14,11 @@
 #include <string>
 #include <vector>
 
+#include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/graph/graph.h"
 
+#include "openvino_tensorflow/graph_shapes.h"
+
 namespace tensorflow {
 namespace openvino_tensorflow {
 
@@ -28,9 +31,12 @@ namespace openvino_tensorflow {
 /// Takes a TF graph where ovtf_cluster attributes has been marked in a
 /// preceeding pass (assign_clusters), then replaces TF subgraphs and inserts
 /// encapsulate ops in their place.
+/// The shapes, if given, were inferred on the graph before encapsulation and
+/// provide the input shapes of the clusters that are compiled ahead.
 Status EncapsulateClusters(
     Graph* graph, int graph_id,
-    const std::unordered_map<std::string, std::string>& device_config);
+    const std::unordered_map<std::string, std::string>& device_config,
+    const GraphShapes* shapes = nullptr);
 
 // TODO Encapsulator is dependent on ClusterManager. They could be made
 // independent.
@@ -56,6 +62,11 @@ class Encapsulator {
   // Needed because ClusterManager (CM) might have contained old stuff,
   // so it might not be possible to query the CM itself to get this
   Status GetNewClusterIDs(std::set<int>& result);
+  // Returns the input shapes of each encapsulate node, taken from shapes
+  // inferred before the RewritePass
+  Status GetClusterInputShapes(
+      const GraphShapes& shapes,
+      std::map<Node*, std::vector<PartialTensorShape>>& result);
 
   Encapsulator(const Encapsulator&) = delete;
   Encapsulator(Encapsulator&&) = delete;
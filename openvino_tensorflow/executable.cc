@@ -11,6 +11,7 @@
 #include "logging/ovtf_log.h"
 #include "openvino_tensorflow/default_opset.h"
 #include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/executable_cache.h"
 #include "openvino_tensorflow/ie_basic_engine.h"
 #include "openvino_tensorflow/ie_tensor.h"
 #include "openvino_tensorflow/ie_utils.h"
@@ -22,8 +23,18 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+std::shared_ptr<ov::Node> MakeStubOutput(const ov::element::Type& type,
+                                         const ov::Shape& shape) {
+  auto value = opset::Constant::create(type, ov::Shape{}, {0});
+  auto target_shape = opset::Constant::create(
+      ov::element::i64, ov::Shape{shape.size()},
+      std::vector<int64_t>(shape.begin(), shape.end()));
+  return std::make_shared<opset::Broadcast>(value, target_shape);
+}
+
 Executable::Executable(shared_ptr<ov::Model> model, string device,
-                       string device_type)
+                       string device_type,
+                       const map<string, string>& compile_properties)
     : m_device{device},
       m_device_type(device_type),
       m_trivial_fn{nullptr},
@@ -148,38 +159,153 @@ Executable::Executable(shared_ptr<ov::Model> model, string device,
   if (m_device == "HDDL") {
     m_ie_engine = make_shared<IE_VADM_Engine>(m_model);
   } else {
-    m_ie_engine = make_shared<IE_Basic_Engine>(m_model, m_device);
+    m_ie_engine =
+        make_shared<IE_Basic_Engine>(m_model, m_device, compile_properties);
   }
+  ChargeEngineModels();
 }
 
-bool Executable::Call(const vector<shared_ptr<ov::Tensor>>& inputs,
-                      vector<shared_ptr<ov::Tensor>>& outputs,
-                      bool multi_req_execution) {
+Executable::Executable(shared_ptr<ov::Model> io_model,
+                       ov::CompiledModel compiled_model,
+                       vector<int> skipped_inputs, string device,
+                       string device_type)
+    : m_device{device},
+      m_device_type(device_type),
+      m_skipped_inputs(skipped_inputs),
+      m_trivial_fn{nullptr},
+      m_model(io_model) {
+  OVTF_VLOG(2) << "Creating IE Execution Engine for a compiled model";
+  m_ie_engine = make_shared<IE_Basic_Engine>(m_model, compiled_model, m_device);
+  ChargeEngineModels();
+}
+
+Executable::~Executable() {
+  // The engine may outlive the executable while it compiles
+  if (m_ie_engine) m_ie_engine->set_extra_size_callback(nullptr);
+}
+
+// The models the engine compiles once the executable is cached are charged
+// to its cache entry. The executable is only used as a key.
+void Executable::ChargeEngineModels() {
+  const Executable* exec = this;
+  m_ie_engine->set_extra_size_callback([exec](int64_t size_bytes) {
+    ExecutableCache::AddSize(exec, size_bytes);
+  });
+}
+
+bool Executable::MakeLean() {
+  if (m_lean) return true;
+  if (!IsCacheable()) return false;
+  // The constants are measured while the model still has them
+  GetSizeBytes();
+  // The engine compiles the model now, its inputs and outputs are all that
+  // is needed afterwards
+  m_ie_engine->get_compiled_model();
+
+  ov::ParameterVector params;
+  for (const auto& param : m_model->get_parameters()) {
+    auto io_param = make_shared<opset::Parameter>(param->get_element_type(),
+                                                  param->get_shape());
+    io_param->set_friendly_name(param->get_friendly_name());
+    params.push_back(io_param);
+  }
+  ov::ResultVector results;
+  for (const auto& result : m_model->get_results()) {
+    auto io_result = make_shared<opset::Result>(
+        MakeStubOutput(result->get_element_type(), result->get_shape()));
+    io_result->set_friendly_name(result->get_friendly_name());
+    results.push_back(io_result);
+  }
+  ov::ResultVector ng_result_list;
+  for (int i = 0; i < m_ng_result_list.size(); i++) {
+    ng_result_list.push_back(make_shared<opset::Result>(MakeStubOutput(
+        m_ng_result_list[i]->get_element_type(), m_ng_output_shapes[i])));
+  }
+
+  m_model = make_shared<ov::Model>(results, params,
+                                   m_model->get_friendly_name());
+  m_ng_result_list = ng_result_list;
+  m_ie_engine->release_model(m_model);
+  m_lean = true;
+  return true;
+}
+
+bool Executable::IsCacheable() const {
+  if (m_trivial_fn || !m_hoisted_params.empty() || m_device == "HDDL") {
+    return false;
+  }
+  for (const auto& param : m_model->get_parameters()) {
+    if (param->get_output_partial_shape(0).is_dynamic()) return false;
+  }
+  for (const auto& result : m_model->get_results()) {
+    if (result->get_output_partial_shape(0).is_dynamic()) return false;
+  }
+  if (m_ng_result_list.size() != m_ng_output_shapes.size()) return false;
+  for (const auto& result : m_ng_result_list) {
+    if (result->get_output_partial_shape(0).is_dynamic()) return false;
+  }
+  return true;
+}
+
+namespace {
+
+int64 ConstantBytes(const shared_ptr<ov::Model>& model) {
+  int64 bytes = 0;
+  for (const auto& node : model->get_ordered_ops()) {
+    if (auto constant = ov::as_type_ptr<opset::Constant>(node)) {
+      bytes += constant->get_byte_size();
+    }
+  }
+  return bytes;
+}
+
+}  // namespace
+
+int64 Executable::GetSizeBytes() {
+  int64 extra_bytes = m_ie_engine ? m_ie_engine->get_extra_size_bytes() : 0;
+  int64 size_bytes = m_size_bytes.load();
+  if (size_bytes >= 0) return size_bytes + extra_bytes;
+
   if (m_trivial_fn) {
-    OVTF_VLOG(2) << "Calling trivial function with inputs=" << inputs.size()
-                 << " outputs=" << outputs.size();
-    return CallTrivial(inputs, outputs);
+    size_bytes = ConstantBytes(m_trivial_fn);
+  } else {
+    size_bytes = ConstantBytes(m_model);
+    for (const auto& param : m_hoisted_params) {
+      size_bytes += param.second->get_byte_size();
+    }
   }
+  m_size_bytes.store(size_bytes);
+  return size_bytes + extra_bytes;
+}
+
+// Arguments for the execution engine, kept alive until an asynchronous
+// inference has completed
+struct Executable::EngineArgs {
+  std::vector<std::shared_ptr<IETensor>> ie_inputs;
+  std::vector<std::shared_ptr<IETensor>> ie_hoisted_params;
+  std::vector<std::shared_ptr<IETensor>> ie_outputs;
+};
 
+// Resolves the friendly names the engine binds the tensors by. They do not
+// change between calls, so this only runs on the first one.
+void Executable::ResolveEngineNames(size_t num_inputs) {
   auto model = m_ie_engine->get_model();
 
   // Check if the number of inputs that the OpenVINO model expects is equal to
   // the
   // sum of the
   // inputs specified and the inputs we hoisted, if any.
-  if (model->inputs().size() > (inputs.size() + m_hoisted_params.size())) {
+  if (model->inputs().size() > (num_inputs + m_hoisted_params.size())) {
     throw runtime_error("Model inputs (" + to_string(model->inputs().size()) +
                         ") number greater than number of given inputs (" +
-                        to_string(inputs.size() + m_hoisted_params.size()) +
+                        to_string(num_inputs + m_hoisted_params.size()) +
                         ")");
   }
 
-  //  Prepare input blobs
   auto parameters = model->get_parameters();
-  std::vector<std::shared_ptr<IETensor>> ie_inputs(inputs.size());
-  std::vector<std::string> input_names(inputs.size());
+  m_input_names.assign(num_inputs, "");
   int j = 0;
-  for (int i = 0; i < inputs.size(); i++) {
+  for (int i = 0; i < num_inputs; i++) {
     if (find(m_skipped_inputs.begin(), m_skipped_inputs.end(), i) !=
         m_skipped_inputs.end()) {
       continue;
@@ -189,57 +315,137 @@ bool Executable::Call(const vector<shared_ptr<ov::Tensor>>& inputs,
       OVTF_VLOG(1) << "Skipping unused input " << input_name;
       continue;
     }
-    ie_inputs[i] = nullptr;
-    ie_inputs[i] = static_pointer_cast<IETensor>(inputs[i]);
-    input_names[i] = input_name;
+    m_input_names[i] = input_name;
   }
 
-  std::vector<std::shared_ptr<IETensor>> ie_hoisted_params(
-      m_hoisted_params.size());
-  std::vector<std::string> param_names(m_hoisted_params.size());
-  for (const auto& it : m_hoisted_params) {
-    auto input_name = it.first;
+  m_param_names.assign(m_hoisted_params.size(), "");
+  for (int i = 0; i < m_hoisted_params.size(); i++) {
+    auto input_name = m_hoisted_params[i].first;
     if (m_ie_engine->get_input_idx(input_name) < 0) {
       OVTF_VLOG(1) << "Skipping unused hoisted param " << input_name;
       continue;
     }
-    ie_hoisted_params[j] = nullptr;
-    ie_hoisted_params[j] = static_pointer_cast<IETensor>(it.second);
-    param_names[j++] = input_name;
+    m_param_names[i] = input_name;
+  }
+
+  auto results = model->get_results();
+  m_output_names.resize(results.size());
+  for (int i = 0; i < results.size(); i++) {
+    m_output_names[i] = results[i]->get_friendly_name();
+  }
+  m_engine_names_resolved = true;
+}
+
+void Executable::PrepareEngineArgs(
+    const vector<shared_ptr<ov::Tensor>>& inputs,
+    vector<shared_ptr<ov::Tensor>>& outputs, EngineArgs& args) {
+  if (!m_engine_names_resolved.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(m_engine_names_mutex);
+    if (!m_engine_names_resolved) ResolveEngineNames(inputs.size());
+  }
+  if (inputs.size() != m_input_names.size()) {
+    throw runtime_error("Expected " + to_string(m_input_names.size()) +
+                        " inputs, got " + to_string(inputs.size()));
+  }
+
+  //  Prepare input blobs, the unused inputs stay null
+  args.ie_inputs.resize(inputs.size());
+  for (int i = 0; i < inputs.size(); i++) {
+    if (!m_input_names[i].empty()) {
+      args.ie_inputs[i] = static_pointer_cast<IETensor>(inputs[i]);
+    }
+  }
+
+  args.ie_hoisted_params.resize(m_hoisted_params.size());
+  for (int i = 0; i < m_hoisted_params.size(); i++) {
+    if (!m_param_names[i].empty()) {
+      args.ie_hoisted_params[i] =
+          static_pointer_cast<IETensor>(m_hoisted_params[i].second);
+    }
   }
 
-  if (outputs.size() == 0 && model->outputs().size() > 0) {
-    outputs.resize(model->outputs().size(), nullptr);
+  if (outputs.size() == 0 && m_output_names.size() > 0) {
+    outputs.resize(m_output_names.size(), nullptr);
   }
 
   //  Prepare output blobs
-  auto results = model->get_results();
-  std::vector<std::shared_ptr<IETensor>> ie_outputs(outputs.size());
-  std::vector<std::string> output_names(outputs.size());
-  for (int i = 0; i < results.size(); i++) {
+  args.ie_outputs.resize(outputs.size());
+  for (int i = 0; i < m_output_names.size(); i++) {
     if (outputs[i] != nullptr) {
-      ie_outputs[i] = static_pointer_cast<IETensor>(outputs[i]);
+      args.ie_outputs[i] = static_pointer_cast<IETensor>(outputs[i]);
     }
-    output_names[i] = results[i]->get_friendly_name();
+  }
+}
+
+bool Executable::Call(const vector<shared_ptr<ov::Tensor>>& inputs,
+                      vector<shared_ptr<ov::Tensor>>& outputs,
+                      bool multi_req_execution) {
+  if (m_trivial_fn) {
+    OVTF_VLOG(2) << "Calling trivial function with inputs=" << inputs.size()
+                 << " outputs=" << outputs.size();
+    return CallTrivial(inputs, outputs);
   }
 
+  EngineArgs args;
+  PrepareEngineArgs(inputs, outputs, args);
+
   if (multi_req_execution) {
     m_ie_engine->enable_multi_req_execution();
   }
 
-  m_ie_engine->infer(ie_inputs, input_names, ie_outputs, output_names,
-                     ie_hoisted_params, param_names);
+  m_ie_engine->infer(args.ie_inputs, m_input_names, args.ie_outputs,
+                     m_output_names, args.ie_hoisted_params, m_param_names);
 
   // Set dynamic output blobs
-  for (int i = 0; i < results.size(); i++) {
+  for (int i = 0; i < args.ie_outputs.size(); i++) {
     if (outputs[i] == nullptr) {
-      outputs[i] = ie_outputs[i];
+      outputs[i] = args.ie_outputs[i];
     }
   }
 
   return true;
 }
 
+void Executable::CallAsync(const vector<shared_ptr<ov::Tensor>>& inputs,
+                           vector<shared_ptr<ov::Tensor>>& outputs,
+                           bool multi_req_execution,
+                           std::function<void(std::exception_ptr)> callback) {
+  if (m_trivial_fn) {
+    OVTF_VLOG(2) << "Calling trivial function with inputs=" << inputs.size()
+                 << " outputs=" << outputs.size();
+    std::exception_ptr exp = nullptr;
+    try {
+      CallTrivial(inputs, outputs);
+    } catch (...) {
+      exp = std::current_exception();
+    }
+    callback(exp);
+    return;
+  }
+
+  auto args = make_shared<EngineArgs>();
+  PrepareEngineArgs(inputs, outputs, *args);
+
+  if (multi_req_execution) {
+    m_ie_engine->enable_multi_req_execution();
+  }
+
+  m_ie_engine->infer_async(
+      args->ie_inputs, m_input_names, args->ie_outputs, m_output_names,
+      args->ie_hoisted_params, m_param_names,
+      [args, &outputs, callback](std::exception_ptr exp) {
+        if (!exp) {
+          // Set dynamic output blobs
+          for (int i = 0; i < args->ie_outputs.size(); i++) {
+            if (outputs[i] == nullptr) {
+              outputs[i] = args->ie_outputs[i];
+            }
+          }
+        }
+        callback(exp);
+      });
+}
+
 bool Executable::CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
                              vector<shared_ptr<ov::Tensor>>& outputs) {
   // outputs are in the same order as results
@@ -6,10 +6,18 @@
 
 #pragma once
 
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+
 #include "openvino/openvino.hpp"
 
 #include "openvino_tensorflow/ie_backend_engine.h"
@@ -19,15 +27,56 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+// The part of the setup of a kernel call that is the same for every call of
+// an executable. Built by the first call and shared by the later ones.
+struct ExecutionPlan {
+  struct Output {
+    // Allocated by OpenVINO, its shape is only known after the inference
+    bool dynamic = false;
+    // Has a zero dim, the compiled model does not compute it
+    bool zero_dim = false;
+    // Index among the outputs of the compiled model, -1 if it has none
+    int func_output = -1;
+    TensorShape tf_shape;
+    ov::element::Type element_type;
+  };
+
+  std::string device;
+  std::vector<ov::element::Type> input_types;
+  std::vector<Output> outputs;
+  // Indices of the dynamic outputs
+  std::vector<int> dynamic_outputs;
+  size_t num_func_outputs = 0;
+};
+
+// Stands in for an output of a compiled model whose translated model is not
+// kept. Only its element type and shape are used, the value is never
+// computed.
+std::shared_ptr<ov::Node> MakeStubOutput(const ov::element::Type& type,
+                                         const ov::Shape& shape);
+
 // A Inference Engine executable object produced by compiling an
 // OpenVINO Model.
 class Executable {
  public:
-  Executable(shared_ptr<ov::Model> model, string device, string device_type);
-  ~Executable() {}
+  // compile_properties are passed to the engine, see IE_Backend_Engine
+  Executable(shared_ptr<ov::Model> model, string device, string device_type,
+             const map<string, string>& compile_properties = {});
+  // Wraps a model that was compiled earlier, e.g. imported from the model
+  // cache. The model only describes the inputs and outputs.
+  Executable(shared_ptr<ov::Model> io_model, ov::CompiledModel compiled_model,
+             vector<int> skipped_inputs, string device, string device_type);
+  ~Executable();
   bool Call(const vector<shared_ptr<ov::Tensor>>& inputs,
             vector<shared_ptr<ov::Tensor>>& outputs,
             bool multi_req_execution = false);
+  // Starts the execution and returns without waiting for it. The callback is
+  // invoked with a null exception_ptr once the outputs are ready, or with the
+  // error otherwise. The inputs and outputs must stay alive until then.
+  void CallAsync(const vector<shared_ptr<ov::Tensor>>& inputs,
+                 vector<shared_ptr<ov::Tensor>>& outputs,
+                 bool multi_req_execution,
+                 std::function<void(std::exception_ptr)> callback);
 
   const ov::ResultVector& GetResults() { return m_model->get_results(); };
 
@@ -45,9 +94,58 @@ class Executable {
 
   const vector<ov::Shape> GetOutputShapes() { return m_ng_output_shapes; }
 
+  // The results of the translated model, including the zero-dim results that
+  // were dropped from the compiled model
+  void SetResultList(const ov::ResultVector& ng_result_list) {
+    m_ng_result_list = ng_result_list;
+  }
+
+  const ov::ResultVector& GetResultList() { return m_ng_result_list; }
+
   void ExportIR(const string& output_dir);
 
+  // True if the compiled model can be exported and later rebuilt from the
+  // description of its inputs and outputs alone
+  bool IsCacheable() const;
+  // Compiles the model and replaces it by a description of its inputs and
+  // outputs, releasing the nodes and constants of the translation. Returns
+  // false if the executable needs the full model, see IsCacheable.
+  bool MakeLean();
+  bool IsLean() const { return m_lean; }
+  // Estimate of the memory the executable holds, without serializing the
+  // compiled model: the bytes of the constants of its model and of the
+  // hoisted parameters, or the size of the compiled model it was imported
+  // from, plus the models its engine compiled later for batch slices. The
+  // former is computed once, lean executables keep the size of their model.
+  int64 GetSizeBytes();
+  // Sets the size of an executable imported from a compiled model
+  void SetSizeBytes(int64 size_bytes) { m_size_bytes.store(size_bytes); }
+  // Compiles the model if that has not happened yet
+  ov::CompiledModel GetCompiledModel() {
+    return m_ie_engine->get_compiled_model();
+  }
+  shared_ptr<ov::Model> GetModel() { return m_model; }
+  const vector<int>& GetSkippedInputs() const { return m_skipped_inputs; }
+
+  // Wrappers of the TF buffers passed as inputs and outputs, by index
+  IETensorPool& GetInputTensorPool() { return m_input_tensor_pool; }
+  IETensorPool& GetOutputTensorPool() { return m_output_tensor_pool; }
+
+  // The plan of the kernel calls, null until the first call has set it
+  shared_ptr<const ExecutionPlan> GetExecutionPlan() const {
+    return std::atomic_load(&m_execution_plan);
+  }
+  void SetExecutionPlan(shared_ptr<const ExecutionPlan> plan) {
+    std::atomic_store(&m_execution_plan, plan);
+  }
+
  private:
+  struct EngineArgs;
+  void ResolveEngineNames(size_t num_inputs);
+  void PrepareEngineArgs(const vector<shared_ptr<ov::Tensor>>& inputs,
+                         vector<shared_ptr<ov::Tensor>>& outputs,
+                         EngineArgs& args);
+  void ChargeEngineModels();
   bool CallTrivial(const vector<shared_ptr<ov::Tensor>>& inputs,
                    vector<shared_ptr<ov::Tensor>>& outputs);
 
@@ -57,12 +155,28 @@ class Executable {
   vector<pair<string, shared_ptr<ov::Tensor>>> m_hoisted_params;
   vector<int> m_skipped_inputs;
   vector<ov::Shape> m_ng_output_shapes;
+  ov::ResultVector m_ng_result_list;
   // This keeps track of whether the original function was trivial: either a
   // constant function, an identity function or a zero function
   shared_ptr<ov::Model> m_trivial_fn;
   // This is the original OpenVINO model corresponding to this executable
   shared_ptr<ov::Model> m_model;
+  // Set once m_model only describes the inputs and outputs
+  bool m_lean = false;
   shared_ptr<IE_Backend_Engine> m_ie_engine;
+  // Friendly names the engine binds the inputs, hoisted parameters and
+  // outputs by, resolved on the first call. An empty name marks an input
+  // the compiled model does not use.
+  std::atomic<bool> m_engine_names_resolved{false};
+  std::mutex m_engine_names_mutex;
+  vector<string> m_input_names;
+  vector<string> m_param_names;
+  vector<string> m_output_names;
+  shared_ptr<const ExecutionPlan> m_execution_plan;
+  // -1 until GetSizeBytes has computed it or SetSizeBytes has set it
+  std::atomic<int64> m_size_bytes{-1};
+  IETensorPool m_input_tensor_pool;
+  IETensorPool m_output_tensor_pool;
 };
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/executable_cache.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex ExecutableCache::s_mutex;
+
+ExecutableCache::State& ExecutableCache::GetState() {
+  static State* state = new State();
+  return *state;
+}
+
+// Reads OPENVINO_TF_EXECUTABLE_CACHE_SIZE_LIMIT unless a limit was set
+// through the API. Requires s_mutex.
+void ExecutableCache::InitLimitLocked(State& state) {
+  if (state.limit_initialized) return;
+  state.limit_initialized = true;
+  string limit_mb = util::GetEnv("OPENVINO_TF_EXECUTABLE_CACHE_SIZE_LIMIT");
+  if (!limit_mb.empty()) {
+    state.limit_bytes =
+        std::max<int64>(0, strtoll(limit_mb.c_str(), nullptr, 10)) * 1024 *
+        1024;
+  }
+}
+
+bool ExecutableCache::Lookup(const void* owner,
+                             const InputSignature& signature,
+                             std::shared_ptr<Executable>& exec) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  auto owner_it = state.owners.find(owner);
+  if (owner_it != state.owners.end()) {
+    auto& owner_entries = owner_it->second;
+    auto it = owner_entries.index.find(signature);
+    if (it != owner_entries.index.end()) {
+      owner_entries.lru.splice(owner_entries.lru.begin(), owner_entries.lru,
+                               it->second);
+      state.lru.splice(state.lru.begin(), state.lru, *it->second);
+      exec = (*it->second)->exec;
+      state.stats.hits++;
+      return true;
+    }
+  }
+  state.stats.misses++;
+  return false;
+}
+
+void ExecutableCache::Insert(const void* owner,
+                             const InputSignature& signature,
+                             std::shared_ptr<Executable> exec,
+                             int64 size_bytes, size_t max_owner_entries) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLimitLocked(state);
+
+  auto& owner_entries = state.owners[owner];
+  auto existing = owner_entries.index.find(signature);
+  if (existing != owner_entries.index.end()) {
+    // Replaced entries do not count as evictions
+    auto entry = *existing->second;
+    state.stats.size_bytes -= entry->size_bytes;
+    state.stats.num_entries--;
+    owner_entries.lru.erase(existing->second);
+    owner_entries.index.erase(existing);
+    state.lru.erase(entry);
+  }
+
+  MakeRoomLocked(state, owner_entries, max_owner_entries);
+
+  state.lru.push_front(Entry{owner, signature, exec, size_bytes});
+  owner_entries.lru.push_front(state.lru.begin());
+  owner_entries.index[signature] = owner_entries.lru.begin();
+  state.stats.size_bytes += size_bytes;
+  state.stats.num_entries++;
+  state.stats.insertions++;
+
+  while (state.limit_bytes > 0 &&
+         state.stats.size_bytes > state.limit_bytes && state.lru.size() > 1) {
+    EvictLocked(state, std::prev(state.lru.end()));
+  }
+
+  OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: Executable cache entries: "
+               << state.stats.num_entries
+               << " Size: " << state.stats.size_bytes / 1024
+               << " KB Limit: " << state.limit_bytes / 1024
+               << " KB Evictions: " << state.stats.evictions;
+}
+
+void ExecutableCache::AddSize(const Executable* exec, int64 size_bytes) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  auto entry = std::find_if(
+      state.lru.begin(), state.lru.end(),
+      [exec](const Entry& entry) { return entry.exec.get() == exec; });
+  if (entry == state.lru.end()) return;
+  entry->size_bytes += size_bytes;
+  state.stats.size_bytes += size_bytes;
+  while (state.limit_bytes > 0 &&
+         state.stats.size_bytes > state.limit_bytes && state.lru.size() > 1) {
+    EvictLocked(state, std::prev(state.lru.end()));
+  }
+}
+
+// Removes an entry from the global and the owner's LRU lists. The owner
+// stays registered even without entries. Requires s_mutex.
+void ExecutableCache::EvictLocked(State& state, EntryList::iterator entry) {
+  auto& owner_entries = state.owners[entry->owner];
+  auto index_it = owner_entries.index.find(entry->signature);
+  owner_entries.lru.erase(index_it->second);
+  owner_entries.index.erase(index_it);
+
+  OVTF_VLOG(2) << "Evicting executable of " << entry->size_bytes / 1024
+               << " KB: " << entry->signature.DebugString();
+  state.stats.size_bytes -= entry->size_bytes;
+  state.stats.num_entries--;
+  state.stats.evictions++;
+  state.stats.evicted_bytes += entry->size_bytes;
+  state.lru.erase(entry);
+}
+
+void ExecutableCache::MakeRoom(const void* owner, size_t max_owner_entries) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  auto owner_it = state.owners.find(owner);
+  if (owner_it == state.owners.end()) return;
+  MakeRoomLocked(state, owner_it->second, max_owner_entries);
+}
+
+// Requires s_mutex
+void ExecutableCache::MakeRoomLocked(State& state, OwnerEntries& owner_entries,
+                                     size_t max_owner_entries) {
+  while (!owner_entries.lru.empty() &&
+         owner_entries.lru.size() >= max_owner_entries) {
+    EvictLocked(state, owner_entries.lru.back());
+  }
+}
+
+void ExecutableCache::EvictOwner(const void* owner) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  auto owner_it = state.owners.find(owner);
+  if (owner_it == state.owners.end()) return;
+  for (auto entry : owner_it->second.lru) {
+    state.stats.size_bytes -= entry->size_bytes;
+    state.stats.num_entries--;
+    state.lru.erase(entry);
+  }
+  state.owners.erase(owner_it);
+}
+
+void ExecutableCache::Clear() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  state.lru.clear();
+  state.owners.clear();
+  state.stats.num_entries = 0;
+  state.stats.size_bytes = 0;
+}
+
+size_t ExecutableCache::NumEntries(const void* owner) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  auto owner_it = state.owners.find(owner);
+  return owner_it == state.owners.end() ? 0 : owner_it->second.lru.size();
+}
+
+void ExecutableCache::SetLimit(int64 limit_bytes) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  state.limit_initialized = true;
+  state.limit_bytes = std::max<int64>(0, limit_bytes);
+  // Shrink right away, down to the most recently used entry
+  while (state.limit_bytes > 0 &&
+         state.stats.size_bytes > state.limit_bytes && state.lru.size() > 1) {
+    EvictLocked(state, std::prev(state.lru.end()));
+  }
+}
+
+int64 ExecutableCache::GetLimit() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLimitLocked(state);
+  return state.limit_bytes;
+}
+
+ExecutableCache::Stats ExecutableCache::GetStats() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  State& state = GetState();
+  InitLimitLocked(state);
+  Stats stats = state.stats;
+  stats.limit_bytes = state.limit_bytes;
+  return stats;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_EXECUTABLE_CACHE_H_
+#define OPENVINO_TF_EXECUTABLE_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/input_signature.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Process-wide cache of the compiled executables of all clusters. Entries
+// are keyed by the owning encapsulate kernel and the input signature, and
+// are charged with their own size, see Executable::GetSizeBytes.
+//
+// The total size is bounded by OPENVINO_TF_EXECUTABLE_CACHE_SIZE_LIMIT (in
+// MB, unlimited by default) or api::SetExecutableCacheLimit, and the number
+// of entries of each owner by the limit passed to Insert. The least recently
+// used entries are evicted first. Evicted executables stay alive until the
+// calls using them have completed.
+class ExecutableCache {
+ public:
+  struct Stats {
+    int64 num_entries = 0;
+    int64 size_bytes = 0;
+    // 0 if the cache size is unlimited
+    int64 limit_bytes = 0;
+    int64 hits = 0;
+    int64 misses = 0;
+    int64 insertions = 0;
+    int64 evictions = 0;
+    int64 evicted_bytes = 0;
+  };
+
+  // Returns true and sets exec if the owner has an executable for the
+  // signature, and marks it as the most recently used one
+  static bool Lookup(const void* owner, const InputSignature& signature,
+                     std::shared_ptr<Executable>& exec);
+  // Adds or replaces an executable costing size_bytes. Evicts entries of the
+  // owner beyond max_owner_entries, then the least recently used entries of
+  // all owners until the cache fits its limit. The new entry itself is never
+  // evicted by its insertion.
+  static void Insert(const void* owner, const InputSignature& signature,
+                     std::shared_ptr<Executable> exec, int64 size_bytes,
+                     size_t max_owner_entries);
+  // Charges the entry of exec with memory it took after its insertion, like
+  // the models its engine compiled for batch slices, and evicts the least
+  // recently used entries until the cache fits its limit again. Executables
+  // that are no longer cached are ignored.
+  static void AddSize(const Executable* exec, int64 size_bytes);
+  // Evicts the least recently used entries of the owner until a new entry
+  // fits in max_owner_entries
+  static void MakeRoom(const void* owner, size_t max_owner_entries);
+  // Evicts all executables of the owner
+  static void EvictOwner(const void* owner);
+  static void Clear();
+
+  static size_t NumEntries(const void* owner);
+  static void SetLimit(int64 limit_bytes);
+  static int64 GetLimit();
+  static Stats GetStats();
+
+ private:
+  struct Entry {
+    const void* owner;
+    InputSignature signature;
+    std::shared_ptr<Executable> exec;
+    int64 size_bytes;
+  };
+  using EntryList = std::list<Entry>;
+  using OwnerList = std::list<EntryList::iterator>;
+  // The entries of one owner, most recently used first, and their position
+  // in that list by signature
+  struct OwnerEntries {
+    OwnerList lru;
+    std::unordered_map<InputSignature, OwnerList::iterator,
+                       InputSignature::Hasher>
+        index;
+  };
+
+  struct State {
+    // All entries, most recently used first
+    EntryList lru;
+    std::unordered_map<const void*, OwnerEntries> owners;
+    int64 limit_bytes = 0;
+    bool limit_initialized = false;
+    Stats stats;
+  };
+
+  // The state is never destroyed, so executables that are still cached at
+  // exit are not released after the OpenVINO plugins were unloaded
+  static State& GetState();
+  static void EvictLocked(State& state, EntryList::iterator entry);
+  static void MakeRoomLocked(State& state, OwnerEntries& owner_entries,
+                             size_t max_owner_entries);
+  static void InitLimitLocked(State& state);
+
+  static std::mutex s_mutex;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_EXECUTABLE_CACHE_H_
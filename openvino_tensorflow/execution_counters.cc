@@ -0,0 +1,28 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <atomic>
+
+#include "openvino_tensorflow/execution_counters.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+namespace {
+
+std::atomic<int64> g_counters[ExecutionCounters::kNumCounters] = {};
+
+}  // namespace
+
+void ExecutionCounters::Increment(Counter counter, int64 count) {
+  g_counters[counter].fetch_add(count, std::memory_order_relaxed);
+}
+
+int64 ExecutionCounters::Get(Counter counter) {
+  return g_counters[counter].load(std::memory_order_relaxed);
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_EXECUTION_COUNTERS_H_
+#define OPENVINO_TF_EXECUTION_COUNTERS_H_
+
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Process-wide counts of the optional execution paths taken by all clusters,
+// so that callers can tell whether a feature was used and not only whether
+// the results were right. Reported by api::GetExecutionStats.
+class ExecutionCounters {
+ public:
+  enum Counter {
+    // Models reshaped from the translated model of other input shapes
+    kTemplateReshapes,
+    // Inferences whose batch was split across the requests of the batch
+    // splitting models
+    kSplitInferences,
+    // Inferences that ran the concatenated calls of a micro-batch, and the
+    // calls they served
+    kMicroBatches,
+    kMicroBatchedCalls,
+    // Executables that released their model after compilation
+    kLeanExecutables,
+    kNumCounters
+  };
+
+  static void Increment(Counter counter, int64 count = 1);
+  static int64 Get(Counter counter);
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_EXECUTION_COUNTERS_H_
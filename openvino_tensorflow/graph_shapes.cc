@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "tensorflow/core/common_runtime/shape_refiner.h"
+#include "tensorflow/core/framework/node_def_util.h"
+#include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/graph/algorithm.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/graph_shapes.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+GraphShapes::GraphShapes(const Graph& graph)
+    : m_output_shapes(graph.num_node_ids()) {
+  ShapeRefiner refiner(graph.versions(), graph.op_registry());
+  refiner.set_require_shape_inference_fns(false);
+  std::vector<Node*> order;
+  GetReversePostOrder(graph, &order);
+  for (auto node : order) {
+    auto& shapes = m_output_shapes[node->id()];
+    shapes.resize(node->num_outputs());
+    // Only a failing shape function leaves the node out, its users then
+    // cannot be added either and keep unknown shapes
+    Status status = refiner.AddNode(node);
+    if (!status.ok()) {
+      OVTF_VLOG(2) << "No shapes inferred for " << node->name() << ": "
+                   << status.error_message();
+      continue;
+    }
+    shape_inference::InferenceContext* context = refiner.GetContext(node);
+    if (context == nullptr) continue;
+
+    // Function arguments carry their shapes as an attribute, which the
+    // shape function of _Arg ignores
+    std::vector<PartialTensorShape> output_shapes;
+    if (node->IsArg() &&
+        GetNodeAttr(node->attrs(), "_output_shapes", &output_shapes).ok() &&
+        output_shapes.size() == 1) {
+      shape_inference::ShapeHandle shape;
+      if (context->MakeShapeFromPartialTensorShape(output_shapes[0], &shape)
+              .ok()) {
+        refiner.SetShape(node, 0, shape).IgnoreError();
+      }
+    }
+
+    for (int i = 0; i < context->num_outputs() && i < (int)shapes.size();
+         i++) {
+      shape_inference::ShapeHandle handle = context->output(i);
+      if (!context->RankKnown(handle)) continue;
+      std::vector<int64> dims;
+      for (int j = 0; j < context->Rank(handle); j++) {
+        dims.push_back(context->Value(context->Dim(handle, j)));
+      }
+      shapes[i] = PartialTensorShape(dims);
+    }
+  }
+}
+
+const PartialTensorShape& GraphShapes::OutputShape(int node_id,
+                                                   int index) const {
+  static const PartialTensorShape* unknown = new PartialTensorShape();
+  if (node_id < 0 || node_id >= (int)m_output_shapes.size()) return *unknown;
+  const auto& shapes = m_output_shapes[node_id];
+  return index >= 0 && index < (int)shapes.size() ? shapes[index] : *unknown;
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
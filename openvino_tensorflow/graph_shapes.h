@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_GRAPH_SHAPES_H_
+#define OPENVINO_TF_GRAPH_SHAPES_H_
+
+#include <vector>
+
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/graph.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Output shapes of the nodes of a graph, inferred statically once per
+// rewrite and shared by the passes that need them: the cluster cost model
+// and the warmup of the clusters whose input shapes the graph fixes.
+//
+// Ops without a shape function have unknown output shapes instead of
+// stopping the inference, and function arguments take the shapes of their
+// _output_shapes attribute.
+class GraphShapes {
+ public:
+  explicit GraphShapes(const Graph& graph);
+
+  // Shape of an output of a node of the graph as it was when the shapes
+  // were inferred. Unknown dimensions are -1.
+  const PartialTensorShape& OutputShape(int node_id, int index) const;
+
+ private:
+  // Output shapes by node id
+  std::vector<std::vector<PartialTensorShape>> m_output_shapes;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_GRAPH_SHAPES_H_
@@ -19,6 +19,7 @@
 #include "openvino_tensorflow/api.h"
 #include "openvino_tensorflow/backend_manager.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/graph_shapes.h"
 #include "openvino_tensorflow/grappler/ovtf_optimizer.h"
 
 #include "ocm/include/ocm_nodes_checker.h"
@@ -187,12 +188,16 @@ Status OVTFOptimizer::Optimize(tensorflow::grappler::Cluster* cluster,
   TF_RETURN_IF_ERROR(AssignClusters(&graph));
   util::DumpTFGraph(&graph, idx, "clustered");
 
+  // The shapes are inferred once, for the cost model of the deassignment and
+  // the warmup of the encapsulated clusters
+  GraphShapes shapes(graph);
+
   // 3. Deassign trivial clusters then, if requested, dump the graphs.
-  TF_RETURN_IF_ERROR(DeassignClusters(&graph));
+  TF_RETURN_IF_ERROR(DeassignClusters(&graph, &shapes));
   util::DumpTFGraph(&graph, idx, "declustered");
 
   // 4. Encapsulate clusters then, if requested, dump the graphs.
-  auto status = EncapsulateClusters(&graph, idx, m_config_map);
+  auto status = EncapsulateClusters(&graph, idx, m_config_map, &shapes);
   if (status != Status::OK()) {
     return status;
   }
@@ -4,26 +4,102 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 
 #include "backend_manager.h"
+#include "logging/ovtf_log.h"
 #include "openvino_tensorflow/ie_backend_engine.h"
 #include "openvino_tensorflow/ie_utils.h"
 
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+IE_Backend_Engine::IE_Backend_Engine(
+    std::shared_ptr<ov::Model> model, std::string device,
+    const std::map<std::string, std::string>& compile_properties)
+    : m_model(model),
+      m_device(device),
+      m_compile_properties(compile_properties),
+      m_multi_req_execution(false),
+      m_network_ready(false),
+      m_req_pool_head(nullptr) {}
+
 IE_Backend_Engine::IE_Backend_Engine(std::shared_ptr<ov::Model> model,
+                                     ov::CompiledModel compiled_model,
                                      std::string device)
     : m_model(model),
+      m_compiled_model(compiled_model),
       m_device(device),
       m_multi_req_execution(false),
-      m_network_ready(false) {}
+      m_network_ready(true),
+      m_req_pool_head(nullptr) {}
+
+// OpenVINO 2022.1 pins the CPU threads through ov::affinity, so
+// enable_cpu_pinning selects between the CORE and NONE affinities
+ov::AnyMap IE_Backend_Engine::to_ov_properties(
+    const std::map<std::string, std::string>& compile_properties,
+    const std::string& dev_type) {
+  ov::AnyMap config;
+  if (compile_properties.empty()) return config;
+
+  std::vector<ov::PropertyName> supported;
+  try {
+    supported = Backend::GetGlobalContext().ie_core.get_property(
+        dev_type, ov::supported_properties);
+  } catch (const std::exception& ex) {
+    OVTF_VLOG(1) << "Cannot query the properties of " << dev_type << ": "
+                 << ex.what();
+    return config;
+  }
+
+  for (const auto& property : compile_properties) {
+    std::string key;
+    std::string value = property.second;
+    if (property.first == "performance_mode") {
+      key = ov::hint::performance_mode.name();
+      std::transform(value.begin(), value.end(), value.begin(), ::toupper);
+    } else if (property.first == "num_streams") {
+      key = ov::num_streams.name();
+    } else if (property.first == "inference_num_threads") {
+      key = ov::inference_num_threads.name();
+    } else if (property.first == "enable_cpu_pinning") {
+      key = ov::affinity.name();
+      std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+      value = (value == "1" || value == "true" || value == "yes") ? "CORE"
+                                                                 : "NONE";
+    } else if (property.first == "inference_precision") {
+      key = ov::hint::inference_precision.name();
+    } else {
+      OVTF_VLOG(1) << "Ignoring unknown compile property " << property.first;
+      continue;
+    }
+    if (std::find(supported.begin(), supported.end(), key) ==
+        supported.end()) {
+      OVTF_VLOG(1) << "Device " << dev_type << " does not support " << key
+                   << ", ignoring " << property.first;
+      continue;
+    }
+    OVTF_VLOG(2) << "Compile property " << key << ": " << value;
+    config[key] = value;
+  }
+  return config;
+}
 
-IE_Backend_Engine::~IE_Backend_Engine() {}
+IE_Backend_Engine::~IE_Backend_Engine() {
+  auto node = m_req_pool_head.load();
+  while (node != nullptr) {
+    auto next = node->next;
+    delete node;
+    node = next;
+  }
+}
 
 void IE_Backend_Engine::load_network() {
-  if (m_network_ready) return;
+  if (m_network_ready.load(std::memory_order_acquire)) return;
+  std::lock_guard<std::mutex> lock(m_load_network_mutex);
+  if (m_network_ready.load(std::memory_order_relaxed)) return;
 
   if (m_device == "MYRIAD") {
     // Set MYRIAD configurations
@@ -44,9 +120,91 @@ void IE_Backend_Engine::load_network() {
   auto backend = BackendManager::GetBackend();
   auto dev_type = backend->GetDeviceType();
   if (dev_type.find("GPU") != string::npos) dev_type = "GPU";
-  m_compiled_model =
-      Backend::GetGlobalContext().ie_core.compile_model(m_model, dev_type);
-  m_network_ready = true;
+  m_compiled_model = Backend::GetGlobalContext().ie_core.compile_model(
+      m_model, dev_type, to_ov_properties(m_compile_properties, dev_type));
+  m_network_ready.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<IE_Backend_Engine::InferRequestSlot>
+IE_Backend_Engine::acquire_infer_request() {
+  load_network();
+  for (auto node = m_req_pool_head.load(std::memory_order_acquire);
+       node != nullptr; node = node->next) {
+    bool expected = false;
+    if (node->slot->busy.compare_exchange_strong(expected, true,
+                                                 std::memory_order_acquire)) {
+      // The previous user may have returned the request from within its
+      // completion callback, wait until the request is idle
+      if (node->slot->started) {
+        try {
+          node->slot->request.wait();
+        } catch (...) {
+          // Errors of the previous inference were reported to its caller
+        }
+      }
+      return node->slot;
+    }
+  }
+
+  // All the pooled requests are busy, add a new one to the pool
+  auto node = new InferRequestNode();
+  node->slot = std::make_shared<InferRequestSlot>();
+  node->slot->busy.store(true, std::memory_order_relaxed);
+  node->slot->request = m_compiled_model.create_infer_request();
+  node->next = m_req_pool_head.load(std::memory_order_relaxed);
+  while (!m_req_pool_head.compare_exchange_weak(node->next, node,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+  }
+  return node->slot;
+}
+
+void IE_Backend_Engine::release_infer_request(
+    const std::shared_ptr<InferRequestSlot>& slot) {
+  slot->busy.store(false, std::memory_order_release);
+}
+
+std::shared_ptr<void> IE_Backend_Engine::lease_infer_request(
+    const std::shared_ptr<InferRequestSlot>& slot) {
+  return std::shared_ptr<void>(
+      nullptr, [slot](void*) { release_infer_request(slot); });
+}
+
+void IE_Backend_Engine::set_extra_size_callback(
+    std::function<void(int64_t)> callback) {
+  std::lock_guard<std::mutex> lock(m_extra_size_mutex);
+  m_extra_size_callback = std::move(callback);
+}
+
+// The callback runs outside of m_extra_size_mutex, it may take the lock of
+// the executable cache, which destroys executables and their engines while
+// holding it
+void IE_Backend_Engine::add_extra_size(int64_t size_bytes) {
+  std::function<void(int64_t)> callback;
+  {
+    std::lock_guard<std::mutex> lock(m_extra_size_mutex);
+    m_extra_size_bytes += size_bytes;
+    callback = m_extra_size_callback;
+  }
+  if (callback) callback(size_bytes);
+}
+
+void IE_Backend_Engine::infer_async(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+    std::vector<std::string>& param_names,
+    std::function<void(std::exception_ptr)> callback) {
+  std::exception_ptr exp = nullptr;
+  try {
+    infer(inputs, input_names, outputs, output_names, hoisted_params,
+          param_names);
+  } catch (...) {
+    exp = std::current_exception();
+  }
+  callback(exp);
 }
 
 void IE_Backend_Engine::start_async_inference(const int req_id) {
@@ -81,15 +239,25 @@ size_t IE_Backend_Engine::get_output_batch_size(size_t inputBatchSize) const {
 
 // Enables multi request execution if the execution engine supprts
 void IE_Backend_Engine::enable_multi_req_execution() {
-  m_multi_req_execution = true;
+  m_multi_req_execution.store(true, std::memory_order_relaxed);
 }
 // Disables multi request execution
 void IE_Backend_Engine::disable_multi_req_execution() {
-  m_multi_req_execution = false;
+  m_multi_req_execution.store(false, std::memory_order_relaxed);
 }
 
 std::shared_ptr<ov::Model> IE_Backend_Engine::get_model() { return m_model; }
 
+ov::CompiledModel IE_Backend_Engine::get_compiled_model() {
+  load_network();
+  return m_compiled_model;
+}
+
+void IE_Backend_Engine::release_model(std::shared_ptr<ov::Model> io_model) {
+  m_model = io_model;
+  m_model_released = true;
+}
+
 const int IE_Backend_Engine::get_input_idx(const std::string name) const {
   for (int i = 0; i < m_model->inputs().size(); i++) {
     if (m_model->inputs()[i].get_node()->get_friendly_name() == name) {
@@ -7,7 +7,12 @@
 #ifndef IE_BACKEND_ENGINE_H_
 #define IE_BACKEND_ENGINE_H_
 
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -18,10 +23,36 @@
 namespace tensorflow {
 namespace openvino_tensorflow {
 
-class IE_Backend_Engine {
+// Engines are owned by shared pointers, the completion callbacks of their
+// requests keep them alive while they run
+class IE_Backend_Engine
+    : public std::enable_shared_from_this<IE_Backend_Engine> {
  public:
-  IE_Backend_Engine(std::shared_ptr<ov::Model> model, std::string device);
-  ~IE_Backend_Engine();
+  // An infer request owned by the engine's request pool. A slot is checked
+  // out by a single caller at a time.
+  struct InferRequestSlot {
+    std::atomic<bool> busy{false};
+    // Set once the request has been started asynchronously
+    bool started = false;
+    ov::InferRequest request;
+    // The tensors last bound to the request, by input, hoisted parameter and
+    // output index. Binding the same tensor again is skipped. The references
+    // are weak so that they do not keep pooled tensors marked as in use.
+    std::vector<std::weak_ptr<IETensor>> bound_inputs;
+    std::vector<std::weak_ptr<IETensor>> bound_params;
+    std::vector<std::weak_ptr<IETensor>> bound_outputs;
+  };
+
+  // compile_properties are the api::kCompilePropertyNames to apply when the
+  // network is loaded, the ones the device does not support are ignored
+  IE_Backend_Engine(
+      std::shared_ptr<ov::Model> model, std::string device,
+      const std::map<std::string, std::string>& compile_properties = {});
+  // Uses a model compiled earlier, the model only has to describe its inputs
+  // and outputs
+  IE_Backend_Engine(std::shared_ptr<ov::Model> model,
+                    ov::CompiledModel compiled_model, std::string device);
+  virtual ~IE_Backend_Engine();
 
   // Executes the inference
   virtual void infer(std::vector<std::shared_ptr<IETensor>>& inputs,
@@ -31,6 +62,18 @@ class IE_Backend_Engine {
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
                      std::vector<std::string>& param_names) = 0;
 
+  // Starts the inference and invokes the callback once it has completed. The
+  // arguments must stay alive until the callback is invoked. Engines that
+  // cannot run asynchronously execute the inference inline.
+  virtual void infer_async(
+      std::vector<std::shared_ptr<IETensor>>& inputs,
+      std::vector<std::string>& input_names,
+      std::vector<std::shared_ptr<IETensor>>& outputs,
+      std::vector<std::string>& output_names,
+      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+      std::vector<std::string>& param_names,
+      std::function<void(std::exception_ptr)> callback);
+
   // Returns output batch size based on the input batch size and the device
   // FIXME: This may not be needed
   virtual size_t get_output_batch_size(size_t inputBatchSize) const;
@@ -42,26 +85,74 @@ class IE_Backend_Engine {
 
   // Returns the OpenVINO Model from the CNNNetwork
   std::shared_ptr<ov::Model> get_model();
+  // Returns the compiled model, loading the network if necessary
+  ov::CompiledModel get_compiled_model();
+  // Replaces the model by one that only describes the inputs and outputs of
+  // the compiled model, which must have been loaded
+  void release_model(std::shared_ptr<ov::Model> io_model);
 
   virtual const std::vector<size_t> get_output_shape(const int i) = 0;
 
   const int get_input_idx(const std::string name) const;
   const int get_output_idx(const std::string name) const;
 
+  // Checks out an idle infer request from the pool without taking a lock.
+  // A new request is created when all the pooled requests are busy, so the
+  // pool grows with the number of concurrent callers.
+  std::shared_ptr<InferRequestSlot> acquire_infer_request();
+  // Returns a request checked out with acquire_infer_request to the pool
+  static void release_infer_request(
+      const std::shared_ptr<InferRequestSlot>& slot);
+  // Returns a handle that releases the slot once the last copy of it is
+  // destroyed. Attach it to tensors that alias the request's memory.
+  static std::shared_ptr<void> lease_infer_request(
+      const std::shared_ptr<InferRequestSlot>& slot);
+
+  // Bytes of the models the engine compiled after it was created, like the
+  // models of batch slices
+  int64_t get_extra_size_bytes() const { return m_extra_size_bytes.load(); }
+  // Invoked with the bytes of each such model once compiled, unless null
+  void set_extra_size_callback(std::function<void(int64_t)> callback);
+
  protected:
   std::shared_ptr<ov::Model> m_model;
   ov::CompiledModel m_compiled_model;
   std::vector<ov::InferRequest> m_infer_reqs;
   std::string m_device;
-  bool m_multi_req_execution;
-  bool m_network_ready;
+  std::map<std::string, std::string> m_compile_properties;
+  // Written by every call that requests it, which may run concurrently
+  std::atomic<bool> m_multi_req_execution;
+  std::atomic<bool> m_network_ready;
+  // Set once m_model was replaced by a description of its inputs and outputs
+  bool m_model_released = false;
+  std::mutex m_load_network_mutex;
   std::vector<int> m_in_idx;
   std::vector<int> m_out_idx;
   std::vector<int> m_param_idx;
 
+  // Accounts for a model compiled after the engine was created
+  void add_extra_size(int64_t size_bytes);
+
   virtual void start_async_inference(const int req_id);
   virtual void complete_async_inference(const int req_id);
   virtual void load_network();
+
+  // Converts compile properties to the OpenVINO properties of the device,
+  // skipping the ones it does not support
+  static ov::AnyMap to_ov_properties(
+      const std::map<std::string, std::string>& compile_properties,
+      const std::string& dev_type);
+
+ private:
+  struct InferRequestNode {
+    std::shared_ptr<InferRequestSlot> slot;
+    InferRequestNode* next;
+  };
+  // Head of the lock-free, grow-only list of pooled infer requests
+  std::atomic<InferRequestNode*> m_req_pool_head;
+  std::atomic<int64_t> m_extra_size_bytes{0};
+  std::mutex m_extra_size_mutex;
+  std::function<void(int64_t)> m_extra_size_callback;
 };
 }  // namespace openvino_tensorflow
 }  // namesoace tensorflow
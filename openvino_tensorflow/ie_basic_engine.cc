@@ -4,10 +4,22 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <algorithm>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
 
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "backend_manager.h"
 #include "logging/ovtf_log.h"
+#include "openvino_tensorflow/batch_analysis.h"
+#include "openvino_tensorflow/compile_scheduler.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/execution_counters.h"
 #include "openvino_tensorflow/ie_basic_engine.h"
 #include "openvino_tensorflow/ie_utils.h"
 
@@ -16,34 +28,54 @@ using namespace InferenceEngine;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
+IE_Basic_Engine::IE_Basic_Engine(
+    std::shared_ptr<ov::Model> model, std::string device,
+    const std::map<std::string, std::string>& compile_properties)
+    : IE_Backend_Engine(model, device, compile_properties) {}
+
 IE_Basic_Engine::IE_Basic_Engine(std::shared_ptr<ov::Model> model,
+                                 ov::CompiledModel compiled_model,
                                  std::string device)
-    : IE_Backend_Engine(model, device) {}
+    : IE_Backend_Engine(model, compiled_model, device) {}
 
 IE_Basic_Engine::~IE_Basic_Engine() {}
 
-void IE_Basic_Engine::infer(
-    std::vector<std::shared_ptr<IETensor>>& inputs,
+// Returns true if the tensor is already bound at index i of the request
+static bool IsBound(std::vector<std::weak_ptr<IETensor>>& bound, size_t i,
+                    const std::shared_ptr<IETensor>& tensor) {
+  if (bound.size() <= i) bound.resize(i + 1);
+  return bound[i].lock() == tensor;
+}
+
+void IE_Basic_Engine::bind_tensors(
+    InferRequestSlot& slot, std::vector<std::shared_ptr<IETensor>>& inputs,
     std::vector<std::string>& input_names,
     std::vector<std::shared_ptr<IETensor>>& outputs,
     std::vector<std::string>& output_names,
     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
     std::vector<std::string>& param_names) {
-  load_network();
-  if (m_infer_reqs.empty()) {
-    m_infer_reqs.push_back(m_compiled_model.create_infer_request());
-  }
-
-  //  Prepare input blobs
-  auto parameters = m_model->get_parameters();
-  if (m_in_idx.size() == 0) {
+  //  Resolve the input, hoisted parameter and output indices
+  auto results = m_model->get_results();
+  std::call_once(m_io_idx_once, [&]() {
     m_in_idx.resize(inputs.size());
     for (int i = 0; i < inputs.size(); i++) {
       if (inputs[i] != nullptr) {
         m_in_idx[i] = get_input_idx(input_names[i]);
       }
     }
-  }
+    m_param_idx.resize(hoisted_params.size());
+    for (int i = 0; i < hoisted_params.size(); i++) {
+      if (hoisted_params[i] != nullptr) {
+        m_param_idx[i] = get_input_idx(param_names[i]);
+      }
+    }
+    m_out_idx.resize(results.size());
+    for (int i = 0; i < results.size(); i++) {
+      m_out_idx[i] = get_output_idx(output_names[i]);
+    }
+  });
+
+  //  Prepare input blobs
   for (int i = 0; i < inputs.size(); i++) {
     if (inputs[i] != nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() set_input_tensor() ("
@@ -53,18 +85,13 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Input with friendly name " + input_names[i] +
                                  " not found in ov::Model");
       }
-      m_infer_reqs[0].set_input_tensor(in_idx, *(inputs[i]));
-    }
-  }
-
-  if (m_param_idx.size() == 0) {
-    m_param_idx.resize(hoisted_params.size());
-    for (int i = 0; i < hoisted_params.size(); i++) {
-      if (hoisted_params[i] != nullptr) {
-        m_param_idx[i] = get_input_idx(param_names[i]);
+      if (!IsBound(slot.bound_inputs, i, inputs[i])) {
+        slot.request.set_input_tensor(in_idx, *(inputs[i]));
+        slot.bound_inputs[i] = inputs[i];
       }
     }
   }
+
   for (int i = 0; i < hoisted_params.size(); i++) {
     if (hoisted_params[i] != nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() set_input_tensor() ("
@@ -74,18 +101,14 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Hoisted parameter with friendly name " +
                                  param_names[i] + " not found in ov::Model");
       }
-      m_infer_reqs[0].set_input_tensor(param_idx, *(hoisted_params[i]));
+      if (!IsBound(slot.bound_params, i, hoisted_params[i])) {
+        slot.request.set_input_tensor(param_idx, *(hoisted_params[i]));
+        slot.bound_params[i] = hoisted_params[i];
+      }
     }
   }
 
   //  Prepare output blobs
-  auto results = m_model->get_results();
-  if (m_out_idx.size() == 0) {
-    m_out_idx.resize(results.size());
-    for (int i = 0; i < results.size(); i++) {
-      m_out_idx[i] = get_output_idx(output_names[i]);
-    }
-  }
   for (int i = 0; i < results.size(); i++) {
     if (outputs[i] != nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() set_output_tensor() ("
@@ -95,14 +118,21 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Output with friendly name " +
                                  output_names[i] + " not found in ov::Model");
       }
-      m_infer_reqs[0].set_output_tensor(out_idx, *(outputs[i]));
+      if (!IsBound(slot.bound_outputs, i, outputs[i])) {
+        slot.request.set_output_tensor(out_idx, *(outputs[i]));
+        slot.bound_outputs[i] = outputs[i];
+      }
     }
   }
+}
 
-  m_infer_reqs[0].infer();
-
-  // Set dynamic output blobs
-  for (int i = 0; i < results.size(); i++) {
+// Sets the dynamic output blobs. They alias the request's memory, so the
+// request stays checked out until the last of them is released.
+void IE_Basic_Engine::collect_dynamic_outputs(
+    const std::shared_ptr<InferRequestSlot>& slot,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names, std::shared_ptr<void>& lease) {
+  for (int i = 0; i < outputs.size(); i++) {
     if (outputs[i] == nullptr) {
       OVTF_VLOG(4) << "IE_Basic_Engine::infer() get_output_tensor() ("
                    << output_names[i] << ")";
@@ -111,12 +141,381 @@ void IE_Basic_Engine::infer(
         throw std::runtime_error("Output with friendly name " +
                                  output_names[i] + " not found in ov::Model");
       }
-      auto tensor = m_infer_reqs[0].get_output_tensor(out_idx);
+      if (lease == nullptr) lease = lease_infer_request(slot);
       outputs[i] = std::make_shared<IETensor>(
-          tensor.get_element_type(), tensor.get_shape(), tensor.data());
+          slot->request.get_output_tensor(out_idx), lease);
+    }
+  }
+}
+
+// Wraps rows [offset, offset + rows) of the batch of the tensor without
+// copying them
+static ov::Tensor BatchSlice(const ov::Tensor& tensor, size_t offset,
+                             size_t rows) {
+  ov::Shape shape = tensor.get_shape();
+  size_t row_bytes = tensor.get_byte_size() / shape[0];
+  shape[0] = rows;
+  return ov::Tensor(tensor.get_element_type(), shape,
+                    static_cast<uint8_t*>(tensor.data()) + offset * row_bytes);
+}
+
+size_t IE_Basic_Engine::get_split_batch(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params) {
+  if (!m_multi_req_execution.load(std::memory_order_relaxed) ||
+      m_device != "CPU" || !hoisted_params.empty() ||
+      m_split_unsupported.load(std::memory_order_relaxed) ||
+      m_model->is_dynamic()) {
+    return 0;
+  }
+  // Every parameter must be batched along dim 0
+  size_t batch = 0;
+  for (const auto& param : m_model->get_parameters()) {
+    const auto& shape = param->get_shape();
+    if (shape.empty()) return 0;
+    if (batch == 0) batch = shape[0];
+    if (shape[0] != batch) return 0;
+  }
+  if (batch < 2) return 0;
+  // The slices are computed apart, so the rows must not depend on each other
+  std::call_once(m_split_check_once, [this]() {
+    std::string reason = "the model was released";
+    if (m_model_released ||
+        !BatchAnalysis::RowsAreIndependent(m_model, reason)) {
+      OVTF_VLOG(1) << "Batch of " << m_model->get_friendly_name()
+                   << " cannot be split: " << reason;
+      m_split_unsupported = true;
     }
+  });
+  if (m_split_unsupported.load(std::memory_order_relaxed)) return 0;
+  return batch;
+}
+
+std::shared_ptr<IE_Basic_Engine::SplitModel> IE_Basic_Engine::get_split_model(
+    size_t batch_size) {
+  std::shared_ptr<SplitModel> split_model;
+  {
+    std::lock_guard<std::mutex> lock(m_split_mutex);
+    auto& entry = m_split_models[batch_size];
+    if (entry == nullptr) entry = std::make_shared<SplitModel>();
+    split_model = entry;
+  }
+  if (split_model->compiled.load(std::memory_order_acquire)) {
+    return split_model;
+  }
+  // Only the full model can be reshaped
+  if (split_model->failed.load() || m_model_released) {
+    m_split_unsupported = true;
+    return nullptr;
+  }
+
+  // The compilation is not queued again while it is in flight. The job
+  // does not keep the engine alive, its executable may be evicted meanwhile.
+  std::ostringstream key;
+  key << "split/" << this << "/" << batch_size;
+  std::weak_ptr<IE_Backend_Engine> weak_engine = shared_from_this();
+  CompileScheduler::Get().Submit(
+      this, key.str(), [weak_engine, split_model, batch_size]() {
+        auto engine =
+            std::static_pointer_cast<IE_Basic_Engine>(weak_engine.lock());
+        if (engine == nullptr) return Status::OK();
+        return engine->compile_split_model(*split_model, batch_size);
+      });
+  return nullptr;
+}
+
+Status IE_Basic_Engine::compile_split_model(SplitModel& split_model,
+                                            size_t batch_size) {
+  if (split_model.compiled.load()) return Status::OK();
+  int64_t size_bytes = 0;
+  try {
+    auto model = m_model->clone();
+    std::map<ov::Output<ov::Node>, ov::PartialShape> shapes;
+    for (const auto& param : model->get_parameters()) {
+      ov::PartialShape shape = param->get_partial_shape();
+      shape[0] = batch_size;
+      shapes[param->output(0)] = shape;
+    }
+    model->reshape(shapes);
+    for (const auto& node : model->get_ordered_ops()) {
+      if (auto constant = ov::as_type_ptr<opset::Constant>(node)) {
+        size_bytes += constant->get_byte_size();
+      }
+    }
+    // The slices run concurrently, so the model is compiled for throughput
+    // unless a performance mode was set explicitly
+    auto properties = m_compile_properties;
+    properties.emplace("performance_mode", "THROUGHPUT");
+    split_model.compiled_model =
+        Backend::GetGlobalContext().ie_core.compile_model(
+            model, m_device, to_ov_properties(properties, m_device));
+  } catch (const std::exception& ex) {
+    split_model.failed = true;
+    return errors::Internal("Cannot compile ", m_model->get_friendly_name(),
+                            " for batch ", batch_size, ": ", ex.what());
+  }
+  uint32_t optimal_requests = split_model.compiled_model.get_property(
+      ov::optimal_number_of_infer_requests);
+  size_t expected = 0;
+  if (m_split_num_requests.compare_exchange_strong(
+          expected, std::max<uint32_t>(1, optimal_requests))) {
+    OVTF_VLOG(2) << "Splitting the batch of " << m_model->get_friendly_name()
+                 << " across " << m_split_num_requests.load() << " requests";
+  }
+  // The copy holds weights of its own
+  add_extra_size(size_bytes);
+  split_model.compiled.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+// The requests of one split inference. They are returned to their models
+// and the callback is invoked once the last of them has completed.
+struct IE_Basic_Engine::SplitCall {
+  std::vector<std::pair<std::shared_ptr<SplitModel>, ov::InferRequest>>
+      requests;
+  std::atomic<size_t> pending{0};
+  std::mutex exp_mutex;
+  std::exception_ptr exp = nullptr;
+  std::function<void(std::exception_ptr)> callback;
+
+  void SetError(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(exp_mutex);
+    if (exp == nullptr) exp = error;
+  }
+  void Complete(size_t count = 1) {
+    if (pending.fetch_sub(count) != count) return;
+    for (auto& request : requests) {
+      std::lock_guard<std::mutex> lock(request.first->requests_mutex);
+      request.first->idle_requests.push_back(std::move(request.second));
+    }
+    requests.clear();
+    auto done = std::move(callback);
+    callback = nullptr;
+    done(exp);
+  }
+};
+
+// Runs the batch slices on concurrent requests. The inputs and outputs of
+// the requests are views of the slices of the caller's tensors.
+bool IE_Basic_Engine::infer_split(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names, size_t batch,
+    std::function<void(std::exception_ptr)> callback) {
+  // The first call of a batch size estimates the number of requests until
+  // the device has reported the optimal one, the slice size is kept so that
+  // no compiled model goes unused
+  size_t slice;
+  {
+    std::lock_guard<std::mutex> lock(m_split_mutex);
+    auto it = m_split_slices.find(batch);
+    if (it == m_split_slices.end()) {
+      size_t num_requests = m_split_num_requests.load();
+      slice = num_requests == 0
+                  ? IE_Utils::GetInputBatchSize(batch, m_device)
+                  : (batch + num_requests - 1) / num_requests;
+      m_split_slices[batch] = slice;
+    } else {
+      slice = it->second;
+    }
+  }
+  size_t num_slices = (batch + slice - 1) / slice;
+  size_t remainder = batch - (num_slices - 1) * slice;
+  auto slice_model = get_split_model(slice);
+  auto last_model =
+      remainder == slice ? slice_model : get_split_model(remainder);
+  if (slice_model == nullptr || last_model == nullptr) return false;
+
+  std::vector<int> in_idx(inputs.size(), -1);
+  for (int i = 0; i < inputs.size(); i++) {
+    if (inputs[i] == nullptr) continue;
+    in_idx[i] = get_input_idx(input_names[i]);
+    if (in_idx[i] < 0) {
+      throw std::runtime_error("Input with friendly name " + input_names[i] +
+                               " not found in ov::Model");
+    }
+  }
+  std::vector<int> out_idx(outputs.size(), -1);
+  for (int i = 0; i < outputs.size(); i++) {
+    out_idx[i] = get_output_idx(output_names[i]);
+    if (out_idx[i] < 0) {
+      throw std::runtime_error("Output with friendly name " +
+                               output_names[i] + " not found in ov::Model");
+    }
+    if (outputs[i] == nullptr) {
+      const auto& output = m_model->outputs()[out_idx[i]];
+      outputs[i] = std::make_shared<IETensor>(output.get_element_type(),
+                                              output.get_shape());
+    }
+  }
+
+  // Concurrent calls take requests of their own from the models
+  auto call = std::make_shared<SplitCall>();
+  call->callback = std::move(callback);
+  for (size_t j = 0; j < num_slices; j++) {
+    auto model = j + 1 == num_slices ? last_model : slice_model;
+    ov::InferRequest request;
+    {
+      std::lock_guard<std::mutex> lock(model->requests_mutex);
+      if (!model->idle_requests.empty()) {
+        request = std::move(model->idle_requests.back());
+        model->idle_requests.pop_back();
+      }
+    }
+    if (request) {
+      // The previous call may have returned the request from within its
+      // completion callback
+      try {
+        request.wait();
+      } catch (...) {
+      }
+    } else {
+      request = model->compiled_model.create_infer_request();
+    }
+    call->requests.emplace_back(model, std::move(request));
+  }
+
+  // One count for each slice and one for this function, so that the call
+  // cannot complete before all slices have been started
+  call->pending = num_slices + 1;
+  size_t started = 0;
+  try {
+    for (; started < num_slices; started++) {
+      auto& request = call->requests[started].second;
+      size_t offset = started * slice;
+      size_t rows = started + 1 == num_slices ? remainder : slice;
+      for (int i = 0; i < inputs.size(); i++) {
+        if (inputs[i] == nullptr) continue;
+        request.set_input_tensor(in_idx[i],
+                                 BatchSlice(*inputs[i], offset, rows));
+      }
+      for (int i = 0; i < outputs.size(); i++) {
+        request.set_output_tensor(out_idx[i],
+                                  BatchSlice(*outputs[i], offset, rows));
+      }
+      // The requests keep the call alive until they have completed. It no
+      // longer holds them once returned to their models.
+      request.set_callback([call](std::exception_ptr exp) {
+        if (exp) call->SetError(exp);
+        call->Complete();
+      });
+      request.start_async();
+    }
+  } catch (...) {
+    call->SetError(std::current_exception());
+  }
+  if (started == num_slices) {
+    ExecutionCounters::Increment(ExecutionCounters::kSplitInferences);
+  }
+  // The slices that were not started will not complete
+  call->Complete(num_slices - started + 1);
+  OVTF_VLOG(4) << "Started " << started << " batch slices";
+  return true;
+}
+
+void IE_Basic_Engine::infer(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+    std::vector<std::string>& param_names) {
+  size_t split_batch = get_split_batch(inputs, hoisted_params);
+  if (split_batch > 0) {
+    std::promise<void> split_done;
+    auto split_future = split_done.get_future();
+    if (infer_split(inputs, input_names, outputs, output_names, split_batch,
+                    [&split_done](std::exception_ptr exp) {
+                      if (exp) {
+                        split_done.set_exception(exp);
+                      } else {
+                        split_done.set_value();
+                      }
+                    })) {
+      split_future.get();
+      OVTF_VLOG(4) << "Inference Successful";
+      return;
+    }
+  }
+
+  // Check out a request from the pool so that concurrent calls on the same
+  // executable do not share an infer request
+  auto slot = acquire_infer_request();
+  std::shared_ptr<void> lease;
+  try {
+    bind_tensors(*slot, inputs, input_names, outputs, output_names,
+                 hoisted_params, param_names);
+    slot->request.infer();
+    collect_dynamic_outputs(slot, outputs, output_names, lease);
+    if (lease == nullptr) release_infer_request(slot);
+  } catch (...) {
+    if (lease == nullptr) release_infer_request(slot);
+    throw;
   }
   OVTF_VLOG(4) << "Inference Successful";
 }
+
+void IE_Basic_Engine::infer_async(
+    std::vector<std::shared_ptr<IETensor>>& inputs,
+    std::vector<std::string>& input_names,
+    std::vector<std::shared_ptr<IETensor>>& outputs,
+    std::vector<std::string>& output_names,
+    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+    std::vector<std::string>& param_names,
+    std::function<void(std::exception_ptr)> callback) {
+  size_t split_batch = get_split_batch(inputs, hoisted_params);
+  if (split_batch > 0 && infer_split(inputs, input_names, outputs,
+                                     output_names, split_batch, callback)) {
+    return;
+  }
+
+  auto slot = acquire_infer_request();
+  try {
+    bind_tensors(*slot, inputs, input_names, outputs, output_names,
+                 hoisted_params, param_names);
+    // The request keeps its callback after completion, so the callback only
+    // holds weak or one-shot references that are dropped once it has run.
+    // The caller may release the engine as soon as the callback is invoked,
+    // so the engine is locked for the duration of the callback and the
+    // request is back in the pool before.
+    std::weak_ptr<IE_Backend_Engine> weak_engine = shared_from_this();
+    std::weak_ptr<InferRequestSlot> weak_slot = slot;
+    auto pending = std::make_shared<std::function<void(std::exception_ptr)>>(
+        std::move(callback));
+    slot->request.set_callback([weak_engine, weak_slot, pending, &outputs,
+                                &output_names](std::exception_ptr exp) {
+      auto engine = std::static_pointer_cast<IE_Basic_Engine>(
+          weak_engine.lock());
+      auto slot = weak_slot.lock();
+      auto done = std::move(*pending);
+      *pending = nullptr;
+      if (engine == nullptr || slot == nullptr || done == nullptr) return;
+      std::shared_ptr<void> lease;
+      if (!exp) {
+        try {
+          engine->collect_dynamic_outputs(slot, outputs, output_names, lease);
+          OVTF_VLOG(4) << "Inference Successful";
+        } catch (...) {
+          exp = std::current_exception();
+        }
+      }
+      if (lease == nullptr) {
+        release_infer_request(slot);
+        done(exp);
+      } else {
+        // The outputs hold the lease, the request returns to the pool once
+        // the caller has released them
+        lease.reset();
+        done(exp);
+      }
+    });
+    slot->started = true;
+    slot->request.start_async();
+  } catch (...) {
+    release_infer_request(slot);
+    throw;
+  }
+}
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -7,11 +7,17 @@
 #ifndef IE_BASIC_ENGINE_H_
 #define IE_BASIC_ENGINE_H_
 
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 #include "openvino/openvino.hpp"
+#include "tensorflow/core/lib/core/status.h"
 
 #include "openvino_tensorflow/ie_backend_engine.h"
 
@@ -22,7 +28,11 @@ class IE_Basic_Engine : public IE_Backend_Engine {
  public:
   // IE_Basic_Engine(InferenceEngine::CNNNetwork ie_network, std::string
   // device);
-  IE_Basic_Engine(std::shared_ptr<ov::Model> model, std::string device);
+  IE_Basic_Engine(
+      std::shared_ptr<ov::Model> model, std::string device,
+      const std::map<std::string, std::string>& compile_properties = {});
+  IE_Basic_Engine(std::shared_ptr<ov::Model> model,
+                  ov::CompiledModel compiled_model, std::string device);
   ~IE_Basic_Engine();
 
   // Executes the inference
@@ -33,9 +43,76 @@ class IE_Basic_Engine : public IE_Backend_Engine {
                      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
                      std::vector<std::string>& param_names);
 
+  // Starts the inference on a pooled request and returns immediately
+  virtual void infer_async(
+      std::vector<std::shared_ptr<IETensor>>& inputs,
+      std::vector<std::string>& input_names,
+      std::vector<std::shared_ptr<IETensor>>& outputs,
+      std::vector<std::string>& output_names,
+      std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+      std::vector<std::string>& param_names,
+      std::function<void(std::exception_ptr)> callback);
+
   virtual const std::vector<size_t> get_output_shape(const int i) {
     return m_model->get_results()[i]->get_shape();
   };
+
+ private:
+  void bind_tensors(InferRequestSlot& slot,
+                    std::vector<std::shared_ptr<IETensor>>& inputs,
+                    std::vector<std::string>& input_names,
+                    std::vector<std::shared_ptr<IETensor>>& outputs,
+                    std::vector<std::string>& output_names,
+                    std::vector<std::shared_ptr<IETensor>>& hoisted_params,
+                    std::vector<std::string>& param_names);
+  void collect_dynamic_outputs(const std::shared_ptr<InferRequestSlot>& slot,
+                               std::vector<std::shared_ptr<IETensor>>& outputs,
+                               std::vector<std::string>& output_names,
+                               std::shared_ptr<void>& lease);
+
+  // A copy of the model compiled for batch slices of one size, and its idle
+  // requests. The model is compiled on the CompileScheduler, the calls run
+  // whole until it is ready.
+  struct SplitModel {
+    std::atomic<bool> compiled{false};
+    std::atomic<bool> failed{false};
+    ov::CompiledModel compiled_model;
+    std::mutex requests_mutex;
+    std::vector<ov::InferRequest> idle_requests;
+  };
+  struct SplitCall;
+  // Returns the batch size of the inputs if the call can be split into
+  // batch slices running on concurrent requests, 0 otherwise
+  size_t get_split_batch(std::vector<std::shared_ptr<IETensor>>& inputs,
+                         std::vector<std::shared_ptr<IETensor>>& hoisted_params);
+  // Returns the model compiled for slices of batch_size, or nullptr while it
+  // is compiling or if it cannot be compiled
+  std::shared_ptr<SplitModel> get_split_model(size_t batch_size);
+  // Compiles the model of a SplitModel, runs on the CompileScheduler
+  Status compile_split_model(SplitModel& split_model, size_t batch_size);
+  // Starts the batch slices on concurrent requests and returns immediately.
+  // The callback is invoked once all of them have completed. Returns false
+  // without invoking it if the model cannot be split, the caller then runs
+  // it whole.
+  bool infer_split(std::vector<std::shared_ptr<IETensor>>& inputs,
+                   std::vector<std::string>& input_names,
+                   std::vector<std::shared_ptr<IETensor>>& outputs,
+                   std::vector<std::string>& output_names, size_t batch,
+                   std::function<void(std::exception_ptr)> callback);
+
+  // Resolves the model input/output indices once, concurrent calls share them
+  std::once_flag m_io_idx_once;
+  // Guards the split models and slice sizes
+  std::mutex m_split_mutex;
+  std::map<size_t, std::shared_ptr<SplitModel>> m_split_models;
+  // The slice size each batch size is split into, fixed by its first call
+  std::map<size_t, size_t> m_split_slices;
+  // The optimal number of requests reported by the device, 0 until the first
+  // split model is compiled
+  std::atomic<size_t> m_split_num_requests{0};
+  // Checks once that the rows of the batch are independent
+  std::once_flag m_split_check_once;
+  std::atomic<bool> m_split_unsupported{false};
 };
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
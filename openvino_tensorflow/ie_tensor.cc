@@ -8,6 +8,8 @@
 #include <memory>
 #include <utility>
 
+#include "tensorflow/core/common_runtime/dma_helper.h"
+
 #include "ie_layouts.h"
 #include "ie_precision.hpp"
 #include "ie_tensor.h"
@@ -26,6 +28,9 @@ IETensor::IETensor(const ov::element::Type& element_type, const Shape& shape_,
 IETensor::IETensor(const ov::element::Type& element_type, const Shape& shape)
     : ov::Tensor(element_type, shape) {}
 
+IETensor::IETensor(const ov::Tensor& tensor, std::shared_ptr<void> owner)
+    : ov::Tensor(tensor), m_owner(owner) {}
+
 // IETensor::IETensor(const ov::element::Type& element_type, const PartialShape&
 // shape)
 //    : ov::Tensor(element_type, shape) {
@@ -52,5 +57,71 @@ void IETensor::read(void* dst, size_t bytes) const {
   copy((uint8_t*)(this->data()), ((uint8_t*)(this->data())) + bytes, dst_ptr);
 }
 
+std::shared_ptr<IETensor> IETensorPool::Get(size_t i,
+                                            const ov::element::Type& type,
+                                            const TensorShape& shape,
+                                            void* data) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_entries.size() <= i) m_entries.resize(i + 1);
+  Entry& entry = m_entries[i];
+  bool reusable = entry.tensor != nullptr && entry.tensor.use_count() == 1 &&
+                  entry.data == data && entry.type == type &&
+                  entry.shape.size() == shape.dims();
+  for (int j = 0; reusable && j < shape.dims(); j++) {
+    reusable = entry.shape[j] == static_cast<size_t>(shape.dim_size(j));
+  }
+  if (!reusable) {
+    entry.shape.resize(shape.dims());
+    for (int j = 0; j < shape.dims(); j++) {
+      entry.shape[j] = shape.dim_size(j);
+    }
+    entry.tensor = make_shared<IETensor>(type, entry.shape, data);
+    entry.data = data;
+    entry.type = type;
+  }
+  return entry.tensor;
+}
+
+#if TF_MAJOR_VERSION >= 2
+IETensorBuffer::IETensorBuffer(std::shared_ptr<ov::Tensor> tensor)
+    : TensorBuffer(tensor->data()), m_tensor(tensor) {}
+
+void IETensorBuffer::FillAllocationDescription(
+    AllocationDescription* proto) const {
+  proto->set_requested_bytes(static_cast<int64>(size()));
+  proto->set_allocator_name("openvino");
+}
+
+bool IETensorBuffer::CanAlias(const ov::Tensor& tensor, DataType dtype) {
+  if (!DataTypeCanUseMemcpy(dtype) || tensor.get_byte_size() == 0) {
+    return false;
+  }
+  return reinterpret_cast<uintptr_t>(tensor.data()) % EIGEN_MAX_ALIGN_BYTES ==
+         0;
+}
+
+std::shared_ptr<ov::Tensor> IETensorBuffer::GetAliasedTensor(
+    const Tensor& tensor, const ov::element::Type& type) {
+  auto buffer =
+      dynamic_cast<const IETensorBuffer*>(DMAHelper::buffer(&tensor));
+  if (buffer == nullptr) return nullptr;
+  const auto& ng_tensor = buffer->m_tensor;
+  // Slices of the result share its buffer but not all of its memory
+  if (ng_tensor->get_element_type() != type ||
+      ng_tensor->data() != tensor.data() ||
+      ng_tensor->get_byte_size() != tensor.TotalBytes()) {
+    return nullptr;
+  }
+  const auto& ng_shape = ng_tensor->get_shape();
+  if (ng_shape.size() != static_cast<size_t>(tensor.dims())) return nullptr;
+  for (int i = 0; i < tensor.dims(); i++) {
+    if (ng_shape[i] != static_cast<size_t>(tensor.dim_size(i))) {
+      return nullptr;
+    }
+  }
+  return ng_tensor;
+}
+#endif
+
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -6,8 +6,13 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/public/version.h"
 
 #include "openvino/openvino.hpp"
 
@@ -19,16 +24,73 @@ class IETensor : public ov::Tensor {
   IETensor(const ov::element::Type& element_type, const ov::Shape& shape);
   IETensor(const ov::element::Type& element_type, const ov::Shape& shape,
            void* memory_pointer);
+  // Shares the memory of an existing tensor. The optional owner is kept alive
+  // for as long as this tensor exists.
+  IETensor(const ov::Tensor& tensor, std::shared_ptr<void> owner = nullptr);
   ~IETensor();
 
   void write(const void* src, size_t bytes);
   void read(void* dst, size_t bytes) const;
 
  private:
+  std::shared_ptr<void> m_owner;
+
   IETensor(const IETensor&) = delete;
   IETensor(IETensor&&) = delete;
   IETensor& operator=(const IETensor&) = delete;
 };
 
+// Reuses the IETensor wrappers of caller-owned buffers across calls. The
+// wrapper of slot i is handed out again when a later call passes the same
+// buffer with the same type and shape while no earlier call still holds it,
+// so steady-state calls do not allocate wrappers. Reused wrappers also let
+// the engines skip rebinding the tensors of their infer requests.
+class IETensorPool {
+ public:
+  std::shared_ptr<IETensor> Get(size_t i, const ov::element::Type& type,
+                                const TensorShape& shape, void* data);
+
+ private:
+  struct Entry {
+    std::shared_ptr<IETensor> tensor;
+    void* data = nullptr;
+    ov::element::Type type;
+    ov::Shape shape;
+  };
+
+  std::mutex m_mutex;
+  std::vector<Entry> m_entries;
+};
+
+#if TF_MAJOR_VERSION >= 2
+// TF tensor buffer aliasing the memory of an OpenVINO tensor, so a result
+// can be handed to TF without a copy. The OpenVINO tensor, and with it the
+// infer request it may belong to, is kept alive for as long as TF uses the
+// buffer.
+class IETensorBuffer : public TensorBuffer {
+ public:
+  explicit IETensorBuffer(std::shared_ptr<ov::Tensor> tensor);
+
+  size_t size() const override { return m_tensor->get_byte_size(); }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override;
+  // The memory belongs to OpenVINO, TF must not forward it to other outputs
+  bool OwnsMemory() const override { return false; }
+
+  // True if the memory of the tensor can back a TF tensor of the given type:
+  // the type is memcpy-able and the data meets Eigen's alignment
+  static bool CanAlias(const ov::Tensor& tensor, DataType dtype);
+  // Returns the OpenVINO tensor whose memory backs all of the TF tensor, or
+  // nullptr if the TF tensor is not an aliased OpenVINO tensor of the given
+  // type. This lets a cluster consume the results of another one as they
+  // are.
+  static std::shared_ptr<ov::Tensor> GetAliasedTensor(
+      const Tensor& tensor, const ov::element::Type& type);
+
+ private:
+  std::shared_ptr<ov::Tensor> m_tensor;
+};
+#endif
+
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -10,9 +10,11 @@
 #ifndef IE_UTILS_H_
 #define IE_UTILS_H_
 
+#include <algorithm>
 #include <atomic>
 #include <mutex>
 #include <ostream>
+#include <thread>
 #include <vector>
 
 #include "openvino/openvino.hpp"
@@ -26,6 +28,10 @@ class IE_Utils {
   static size_t GetMaxReq(std::string device) {
     int max_req = 1;
     if (device == "HDDL") max_req = 8;
+    // An estimate of the throughput streams, the engine switches to the
+    // optimal number of requests of the compiled model once it is known
+    if (device == "CPU")
+      max_req = std::max(1, (int)std::thread::hardware_concurrency() / 4);
     return max_req;
   }
 
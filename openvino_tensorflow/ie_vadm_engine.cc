@@ -53,6 +53,7 @@ void IE_VADM_Engine::infer(
     std::vector<std::string>& output_names,
     std::vector<std::shared_ptr<IETensor>>& hoisted_params,
     std::vector<std::string>& param_names) {
+  std::lock_guard<std::mutex> lock(m_infer_mutex);
   // Batch size is 0 and the number of requests is 1 when
   // multi request execution is disabled.
   int num_req = 1;
@@ -180,8 +181,11 @@ void IE_VADM_Engine::infer(
       ov::Shape out_shape = tensor.get_shape();
       if (batch_size == 0 || out_shape.size() < 2 ||
           out_shape[0] != batch_size) {
-        outputs[i] = std::make_shared<IETensor>(tensor.get_element_type(),
-                                                out_shape, tensor.data());
+        // The request is reused as soon as the lock is released, so the
+        // result is copied out instead of aliasing the request's memory
+        outputs[i] =
+            std::make_shared<IETensor>(tensor.get_element_type(), out_shape);
+        outputs[i]->write(tensor.data(), tensor.get_byte_size());
       } else {
         out_shape[0] = m_orig_batch_size;
         size_t req_size = tensor.get_byte_size();
@@ -8,6 +8,7 @@
 #define IE_VADM_ENGINE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,9 @@ class IE_VADM_Engine : public IE_Backend_Engine {
 
  private:
   int m_orig_batch_size;
+  // The batch split reshapes the model and shares m_infer_reqs, so calls on
+  // the same executable are serialized
+  std::mutex m_infer_mutex;
 };
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
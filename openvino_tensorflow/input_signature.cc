@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
+
+#include "openvino_tensorflow/input_signature.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+namespace {
+
+// Appends the encoding to a buffer
+class SignatureWriter {
+ public:
+  explicit SignatureWriter(std::string* bytes) : m_bytes(bytes) {}
+  bool Put(const void* data, size_t size) {
+    m_bytes->append(static_cast<const char*>(data), size);
+    return true;
+  }
+
+ private:
+  std::string* m_bytes;
+};
+
+// Compares the encoding against an existing buffer, stops at the first
+// difference
+class SignatureReader {
+ public:
+  explicit SignatureReader(const std::string& bytes) : m_bytes(bytes) {}
+  bool Put(const void* data, size_t size) {
+    if (m_pos + size > m_bytes.size() ||
+        std::memcmp(m_bytes.data() + m_pos, data, size) != 0) {
+      return false;
+    }
+    m_pos += size;
+    return true;
+  }
+  bool AtEnd() const { return m_pos == m_bytes.size(); }
+
+ private:
+  const std::string& m_bytes;
+  size_t m_pos = 0;
+};
+
+// Encoding: for each input its rank and dims, then for each static input
+// its data type and contents. A dynamic input is encoded as -1 - rank
+// without dims, which keeps it distinct from any static encoding. Returns
+// false if the sink rejects a value or a static input cannot be encoded.
+template <typename Sink>
+bool EncodeSignature(const std::vector<Tensor>& inputs,
+                     const std::vector<bool>& input_is_static,
+                     const std::vector<bool>& input_is_dynamic, Sink& sink) {
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const TensorShape& shape = inputs[i].shape();
+    if (i < input_is_dynamic.size() && input_is_dynamic[i]) {
+      int64 dynamic_rank = -1 - shape.dims();
+      if (!sink.Put(&dynamic_rank, sizeof(dynamic_rank))) return false;
+      continue;
+    }
+    int64 rank = shape.dims();
+    if (!sink.Put(&rank, sizeof(rank))) return false;
+    for (int d = 0; d < shape.dims(); d++) {
+      int64 dim = shape.dim_size(d);
+      if (!sink.Put(&dim, sizeof(dim))) return false;
+    }
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (i >= input_is_static.size() || !input_is_static[i]) continue;
+    if (!DataTypeCanUseMemcpy(inputs[i].dtype())) return false;
+    int64 dtype = inputs[i].dtype();
+    if (!sink.Put(&dtype, sizeof(dtype))) return false;
+    auto data = inputs[i].tensor_data();
+    if (!sink.Put(data.data(), data.size())) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+Status InputSignature::Compute(const std::vector<Tensor>& inputs,
+                               const std::vector<bool>& input_is_static,
+                               const std::vector<bool>& input_is_dynamic) {
+  m_bytes.clear();
+  m_valid = false;
+  SignatureWriter writer(&m_bytes);
+  if (!EncodeSignature(inputs, input_is_static, input_is_dynamic, writer)) {
+    for (size_t i = 0; i < inputs.size() && i < input_is_static.size(); i++) {
+      if (input_is_static[i] && !DataTypeCanUseMemcpy(inputs[i].dtype())) {
+        return errors::Internal("Static input ", i,
+                                " has unsupported data type ",
+                                DataType_Name(inputs[i].dtype()));
+      }
+    }
+    return errors::Internal("Failed to encode input signature");
+  }
+  m_hash = Hash64(m_bytes.data(), m_bytes.size());
+  m_valid = true;
+  return Status::OK();
+}
+
+bool InputSignature::Matches(const std::vector<Tensor>& inputs,
+                             const std::vector<bool>& input_is_static,
+                             const std::vector<bool>& input_is_dynamic) const {
+  if (!m_valid) return false;
+  SignatureReader reader(m_bytes);
+  return EncodeSignature(inputs, input_is_static, input_is_dynamic, reader) &&
+         reader.AtEnd();
+}
+
+std::string InputSignature::DebugString() const {
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << m_hash << std::dec
+      << " (" << m_bytes.size() << " bytes)";
+  return oss.str();
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_INPUT_SIGNATURE_H_
+#define OPENVINO_TF_INPUT_SIGNATURE_H_
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Binary key of the executable cache. It encodes the dims of every input
+// followed by the raw bytes of the static inputs. Inputs compiled with
+// dynamic shapes only contribute their rank. Lookups use a 64-bit hash
+// of the encoding and equality compares the full encoding, so hash
+// collisions never select the wrong executable.
+class InputSignature {
+ public:
+  InputSignature() = default;
+
+  // Builds the signature. Fails if a static input has a data type whose
+  // contents cannot be copied as raw bytes.
+  Status Compute(const std::vector<Tensor>& inputs,
+                 const std::vector<bool>& input_is_static,
+                 const std::vector<bool>& input_is_dynamic = {});
+
+  // Returns true if the inputs encode to this signature. This compares in
+  // place without building a new one, which makes it cheap to check whether
+  // a call repeats the previous one.
+  bool Matches(const std::vector<Tensor>& inputs,
+               const std::vector<bool>& input_is_static,
+               const std::vector<bool>& input_is_dynamic = {}) const;
+
+  uint64 Hash() const { return m_hash; }
+  bool IsValid() const { return m_valid; }
+  size_t ByteSize() const { return m_bytes.size(); }
+  const std::string& Bytes() const { return m_bytes; }
+  std::string DebugString() const;
+
+  bool operator==(const InputSignature& other) const {
+    return m_hash == other.m_hash && m_bytes == other.m_bytes;
+  }
+  bool operator!=(const InputSignature& other) const {
+    return !(*this == other);
+  }
+
+  struct Hasher {
+    size_t operator()(const InputSignature& signature) const {
+      return static_cast<size_t>(signature.Hash());
+    }
+  };
+
+ private:
+  std::string m_bytes;
+  uint64 m_hash = 0;
+  bool m_valid = false;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_INPUT_SIGNATURE_H_
@@ -3,8 +3,19 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
+#include <unordered_set>
 #include <utility>
 
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -16,7 +27,9 @@
 #include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/public/version.h"
 #if (TF_MAJOR_VERSION >= 2) && (TF_MINOR_VERSION > 2)
 #include "tensorflow/core/common_runtime/graph_constructor.h"
@@ -27,12 +40,26 @@
 #include "tensorflow/core/public/session.h"
 
 #include "logging/ovtf_log.h"
+#include "openvino_tensorflow/api.h"
 #include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/backend_selector.h"
+#include "openvino_tensorflow/batch_analysis.h"
 #include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/cluster_profile.h"
+#include "openvino_tensorflow/compile_scheduler.h"
+#include "openvino_tensorflow/constant_pool.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/executable_cache.h"
+#include "openvino_tensorflow/execution_counters.h"
+#include "openvino_tensorflow/ie_tensor.h"
+#include "openvino_tensorflow/input_signature.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
+#include "openvino_tensorflow/micro_batcher.h"
+#include "openvino_tensorflow/model_cache.h"
 #include "openvino_tensorflow/ovtf_builder.h"
 #include "openvino_tensorflow/ovtf_timer.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/warmup.h"
 
 #ifdef _WIN32
 #define EXPAND(x) x
@@ -47,33 +74,186 @@ using namespace std;
 namespace tensorflow {
 namespace openvino_tensorflow {
 
-class NGraphEncapsulateOp : public OpKernel {
+// Input mask used when the model is compiled with static shapes
+static const std::vector<bool> kNoDynamicInputs;
+
+class NGraphEncapsulateOp : public AsyncOpKernel {
  public:
   explicit NGraphEncapsulateOp(OpKernelConstruction* ctx);
   ~NGraphEncapsulateOp() override;
-  void Compute(OpKernelContext* ctx) override;
+  void ComputeAsync(OpKernelContext* ctx, DoneCallback done) override;
 
  private:
+  // Per-call state that has to outlive ComputeAsync until the inference
+  // completion callback has run
+  struct ExecutionState {
+    std::shared_ptr<Executable> ng_exec;
+    std::shared_ptr<const ExecutionPlan> plan;
+    std::vector<std::shared_ptr<ov::Tensor>> ng_inputs;
+    std::vector<std::shared_ptr<ov::Tensor>> ng_func_outputs;
+    int64 step_id;
+    int64 input_bytes = 0;
+    // Real and padded batch size when the batch was bucketed, else -1
+    int64 batch = -1;
+    int64 padded_batch = -1;
+    // Outputs computed on the padded batch, sliced once the inference is done
+    std::map<int, Tensor> padded_outputs;
+    // Time spent wrapping the inputs and outputs, for the cluster profile
+    int64 boundary_us = 0;
+    // Set when the call is timed for the backend selector
+    bool sample_backend = false;
+    InputSignature backend_signature;
+    Timer compute_time;
+    Timer execute_function;
+  };
+
+  // State of a batch of coalesced calls, kept until its inference completes
+  struct MicroBatchState {
+    std::vector<MicroBatcher::Request> requests;
+    std::shared_ptr<Executable> ng_exec;
+    std::vector<std::shared_ptr<ov::Tensor>> ng_inputs;
+    std::vector<std::shared_ptr<ov::Tensor>> ng_func_outputs;
+    // Batched inputs and outputs, rows beyond the calls' ones are padding
+    std::vector<Tensor> inputs;
+    std::vector<Tensor> outputs;
+  };
+
+  void ComputeUnbatched(OpKernelContext* ctx, DoneCallback done);
+  bool GetMicroBatchKey(OpKernelContext* ctx, std::string& key,
+                        int64& rows);
+  void RunMicroBatch(const std::string& key,
+                     std::vector<MicroBatcher::Request> requests);
+  Status PrepareMicroBatch(const std::string& key, MicroBatchState& state);
+  Status BuildExecutionPlan(OpKernelContext* ctx, Executable& ng_exec,
+                            std::shared_ptr<const ExecutionPlan>& plan);
+  Status ProcessOutputs(OpKernelContext* ctx, ExecutionState& state);
+  Status SetOutputTensor(OpKernelContext* ctx, int i,
+                         const TensorShape& tf_shape,
+                         const std::shared_ptr<ov::Tensor>& ng_output);
   Status GetExecutable(const std::vector<Tensor>& tf_input_tensors,
                        std::shared_ptr<Executable>& ng_exec);
+  Status BuildExecutable(const std::vector<Tensor>& tf_input_tensors,
+                         bool dynamic,
+                         const api::CompileProperties& compile_properties,
+                         const std::string& model_cache_key,
+                         std::shared_ptr<Executable>& ng_exec);
+  bool UseDynamicShapes(const std::vector<Tensor>& tf_input_tensors);
+  api::CompileProperties GetCompileProperties() const;
+  std::string GetModelCacheKey(
+      const InputSignature& signature,
+      const api::CompileProperties& compile_properties);
+  std::string GetJobKey(const InputSignature& signature);
+  CompileScheduler::SubmitResult SubmitCompilation(
+      const std::vector<Tensor>& tf_input_tensors,
+      const InputSignature& signature, bool dynamic,
+      std::shared_ptr<WarmupRegistry::PendingCompilation> pending = nullptr);
+  void QueueWarmup(OpKernelConstruction* ctx,
+                   const std::vector<PartialTensorShape>& warmup_shapes);
+  std::shared_ptr<ov::Model> SpecializeModelTemplate(
+      const std::vector<Tensor>& tf_input_tensors,
+      const std::vector<TensorShape>& input_shapes,
+      const std::vector<const Tensor*>& static_input_map, bool dynamic);
+  Status PadBatch(OpKernelContext* ctx, std::vector<Tensor>& tf_input_tensors,
+                  ExecutionState& state);
+  bool RowsAreIndependent(const std::vector<Tensor>& tf_input_tensors);
+  void AnalyzeRows(const std::vector<Tensor>& tf_input_tensors,
+                   std::shared_ptr<ov::Model> ng_function);
+  size_t GetCacheDepth();
+  void InsertExecutable(const InputSignature& signature,
+                        std::shared_ptr<Executable> ng_exec);
   Status Fallback(OpKernelContext* ctx);
-
-  std::mutex m_compute_lock_;
-  Graph m_graph;
+  Status RunFallbackSession(OpKernelContext* ctx);
+  bool SampleTF();
+  Status GetGraph(std::shared_ptr<Graph>& graph);
+  void ReleaseGraph();
+
+  // Guards the compilation state of the cluster. Inference runs outside of
+  // this lock.
+  std::mutex m_exec_cache_mutex;
+  // Guards the lazy creation of the fallback session
+  std::mutex m_fallback_mutex;
+  // The cluster graph. Lean kernels release it after each translation and
+  // rebuild it from m_graph_def or the cluster manager's GraphDef.
+  std::shared_ptr<Graph> m_graph;
+  std::mutex m_graph_mutex;
+  // Copy of a cluster graph read from the function library, lean kernels only
+  GraphDef m_graph_def;
+  // Set by OPENVINO_TF_LEAN_EXECUTABLES
+  bool m_lean = false;
   int m_cluster_id;
   int m_function_cache_depth_in_items = 16;
+  // Set by OPENVINO_TF_ENABLE_BATCHING
+  bool m_multi_req_execution = false;
   string m_name;
   std::vector<bool> m_input_is_static;
-  std::list<std::string> m_lru;
-  std::unordered_map<std::string, std::shared_ptr<Executable>> m_ng_exec_map;
-  ngraph::ResultVector ng_result_list;
+  // The non-static inputs, compiled with dynamic dims in dynamic shape mode
+  std::vector<bool> m_input_is_dynamic;
+  bool m_dynamic_shapes = false;
+  // Set once the cluster failed to compile with dynamic shapes
+  bool m_dynamic_shapes_unsupported = false;
+  // Pads the batch dim of the inputs up to a power of two
+  bool m_batch_bucketing = false;
+  // Results of the batch analysis of the translations, keyed like the model
+  // templates by the values of the static inputs. Batches are only padded or
+  // coalesced once the analysis proved that their rows are independent.
+  std::mutex m_row_independence_mutex;
+  std::unordered_map<InputSignature, bool, InputSignature::Hasher>
+      m_row_independence;
+  // Coalesces concurrent calls into one inference, null unless
+  // OPENVINO_TF_MICRO_BATCH_WINDOW_US is set
+  std::unique_ptr<MicroBatcher> m_micro_batcher;
+  // Picks OpenVINO or native TF for each signature, null unless
+  // OPENVINO_TF_ADAPTIVE_BACKEND is set
+  std::unique_ptr<BackendSelector> m_backend_selector;
+  // Input shapes, without the batch dim, whose outputs cannot be batched
+  std::mutex m_micro_batch_mutex;
+  std::set<std::string> m_unbatchable_keys;
+  // OpenVINO properties set for the graph of the kernel through the grappler
+  // parameter map, as _ovtf_<name> attributes. They override the global ones.
+  api::CompileProperties m_graph_compile_properties;
+  // Models translated with dynamic dims for the non-static inputs, keyed by
+  // the values of the static inputs, oldest first in m_model_template_order.
+  // Misses that only change the shapes of the non-static inputs reshape a
+  // copy instead of translating the graph again. Null templates mark static
+  // input values that always need a full translation.
+  std::mutex m_model_template_mutex;
+  std::unordered_map<InputSignature, std::shared_ptr<ov::Model>,
+                     InputSignature::Hasher>
+      m_model_templates;
+  std::deque<InputSignature> m_model_template_order;
+  bool m_model_templates_enabled = false;
+  // Set once the cluster failed to translate with dynamic shapes
+  bool m_model_templates_unsupported = false;
+  // Fingerprint of m_graph for the model cache key, computed on first use
+  uint64 m_graph_fingerprint = 0;
+  bool m_graph_fingerprint_valid = false;
+  // Signatures compiled by a call, the concurrent misses of them wait on
+  // m_compiled_cv instead of compiling them again
+  std::unordered_set<InputSignature, InputSignature::Hasher> m_compiling;
+  std::condition_variable m_compiled_cv;
+  // Errors of background compilations, reported by later calls
+  std::unordered_map<InputSignature, Status, InputSignature::Hasher>
+      m_failed_signatures;
+  // Signature of the previous call, checked first to skip building a new one
+  InputSignature m_last_signature;
+  // Time spent computing signatures, reported in the timing profile
+  std::atomic<int64> m_signature_time_ns{0};
+  std::atomic<int64> m_signature_count{0};
   std::shared_ptr<tensorflow::Session> m_session;
   std::vector<std::string> m_session_input_names;
   std::vector<std::string> m_session_output_names;
+  // Set once the fallback session has run, its first run is not profiled
+  std::atomic<bool> m_session_warm{false};
+  // Set by OPENVINO_TF_CLUSTER_PROFILE, the measurements of the cluster are
+  // recorded under the fingerprint of its node names
+  bool m_profile = false;
+  uint64 m_profile_fingerprint = 0;
+  std::atomic<int64> m_profile_calls{0};
 };
 
 NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
-    : OpKernel(ctx), m_graph(OpRegistry::Global()) {
+    : AsyncOpKernel(ctx),
+      m_graph(std::make_shared<Graph>(OpRegistry::Global())) {
   OVTF_VLOG(1) << "Create Executor " << name();
   m_name = name();
 
@@ -105,11 +285,12 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
     if (!status.ok()) {
       OVTF_VLOG(2) << "FunctionDefToBodyHelper returned a not ok status.";
     }
-    CopyGraph(*fnbody->graph, &m_graph);
+    CopyGraph(*fnbody->graph, m_graph.get());
   } else {
     GraphConstructorOptions opts;
     opts.allow_internal_ops = true;
-    OP_REQUIRES_OK(ctx, ConvertGraphDefToGraph(opts, *graph_def, &m_graph));
+    OP_REQUIRES_OK(ctx,
+                   ConvertGraphDefToGraph(opts, *graph_def, m_graph.get()));
   }
 
   //
@@ -124,7 +305,7 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
   int32 max_arg_index = -1;
   std::vector<const Node*> arg_nodes;
 
-  for (auto node : m_graph.nodes()) {
+  for (auto node : m_graph->nodes()) {
     if (node->type_string() == "_Arg") {
       arg_nodes.push_back(node);
 
@@ -163,17 +344,324 @@ NGraphEncapsulateOp::NGraphEncapsulateOp(OpKernelConstruction* ctx)
     OVTF_VLOG(5) << "Marking arg " << index << " is_static: " << is_static;
     m_input_is_static[index] = is_static;
   }
+
+  if (ClusterProfile::IsEnabled()) {
+    std::vector<std::string> node_names;
+    for (auto node : m_graph->op_nodes()) {
+      if (!node->IsArg() && !node->IsRetval()) {
+        node_names.push_back(node->name());
+      }
+    }
+    m_profile = true;
+    m_profile_fingerprint = ClusterProfile::Fingerprint(node_names);
+  }
+
+  // Dynamic shapes and batch bucketing are opt-in. Dynamic shapes are only
+  // supported by the CPU plugin, padded batches are not split on VAD-M.
+  string backend_name;
+  if (BackendManager::GetBackendName(backend_name).ok()) {
+    m_dynamic_shapes = util::GetEnv("OPENVINO_TF_DYNAMIC_SHAPES") == "1" &&
+                       backend_name == "CPU";
+    m_batch_bucketing = util::GetEnv("OPENVINO_TF_BATCH_BUCKETING") == "1" &&
+                        backend_name != "HDDL";
+  }
+  m_input_is_dynamic.resize(size);
+  for (int i = 0; i < size; i++) {
+    m_input_is_dynamic[i] = !m_input_is_static[i];
+  }
+  m_model_templates_enabled =
+      util::GetEnv("OPENVINO_TF_MODEL_TEMPLATES") == "1";
+
+  // Lean kernels keep the compiled models and the cluster GraphDef only.
+  // Model templates would keep translated models alive.
+  m_lean = util::GetEnv("OPENVINO_TF_LEAN_EXECUTABLES") == "1";
+  if (m_lean) {
+    m_model_templates_enabled = false;
+    if (graph_def == nullptr) m_graph->ToGraphDef(&m_graph_def);
+  }
+
+  for (const auto& property_name : api::kCompilePropertyNames) {
+    std::string attr_name = "_ovtf_" + property_name;
+    if (!ctx->HasAttr(attr_name)) continue;
+    std::string value;
+    OP_REQUIRES_OK(ctx, ctx->GetAttr(attr_name, &value));
+    m_graph_compile_properties[property_name] = value;
+  }
+
+  if (std::getenv("OPENVINO_TF_ENABLE_BATCHING")) {
+    OVTF_VLOG(2) << "Batching is enabled" << name();
+    m_multi_req_execution = true;
+  }
+
+  // The values of static inputs are part of the signature, so only clusters
+  // without them can coalesce calls
+  int64 micro_batch_window_us =
+      strtoll(util::GetEnv("OPENVINO_TF_MICRO_BATCH_WINDOW_US").c_str(),
+              nullptr, 10);
+  if (micro_batch_window_us > 0 && !m_batch_bucketing &&
+      std::none_of(m_input_is_static.begin(), m_input_is_static.end(),
+                   [](bool is_static) { return is_static; })) {
+    int64 max_rows = 32;
+    std::string max_rows_env = util::GetEnv("OPENVINO_TF_MICRO_BATCH_SIZE");
+    if (!max_rows_env.empty()) {
+      max_rows = std::max<int64>(1, strtoll(max_rows_env.c_str(), nullptr, 10));
+    }
+    // Closed batches run on the TF worker threads, the batcher's timer
+    // thread only closes them
+    m_micro_batcher.reset(new MicroBatcher(
+        std::chrono::microseconds(micro_batch_window_us), max_rows,
+        [this](const std::string& key,
+               std::vector<MicroBatcher::Request> requests) {
+          auto workers = requests[0]
+                             .ctx->device()
+                             ->tensorflow_cpu_worker_threads()
+                             ->workers;
+          workers->Schedule([this, key, requests]() {
+            RunMicroBatch(key, requests);
+          });
+        }));
+  }
+
+  if (util::GetEnv("OPENVINO_TF_ADAPTIVE_BACKEND") == "1") {
+    int64 resample_calls = 1000;
+    std::string resample_env =
+        util::GetEnv("OPENVINO_TF_ADAPTIVE_RESAMPLE_CALLS");
+    if (!resample_env.empty()) {
+      resample_calls = strtoll(resample_env.c_str(), nullptr, 10);
+    }
+    m_backend_selector.reset(new BackendSelector(5, resample_calls));
+  }
+
+  if (ctx->HasAttr(kWarmupShapesAttr)) {
+    std::vector<PartialTensorShape> warmup_shapes;
+    OP_REQUIRES_OK(ctx, ctx->GetAttr(kWarmupShapesAttr, &warmup_shapes));
+    QueueWarmup(ctx, warmup_shapes);
+  }
 }
 
 NGraphEncapsulateOp::~NGraphEncapsulateOp() {
   std::ostringstream oss;
   oss << "Destroy Encapsulate_" << m_cluster_id << ": " << name();
   OVTF_VLOG(2) << "~NGraphEncapsulateOp::" << name();
+  // Background compilations refer to this kernel
+  CompileScheduler::Get().Drain(this);
   NGraphClusterManager::SetMRUExecutable(m_cluster_id, nullptr);
-  m_ng_exec_map.clear();
+  ExecutableCache::EvictOwner(this);
+}
+
+void NGraphEncapsulateOp::ComputeAsync(OpKernelContext* ctx,
+                                       DoneCallback done) {
+  if (m_micro_batcher != nullptr &&
+      !NGraphClusterManager::CheckClusterFallback(m_cluster_id)) {
+    std::string key;
+    int64 rows;
+    if (GetMicroBatchKey(ctx, key, rows)) {
+      m_micro_batcher->Add(key, {ctx, done, rows});
+      return;
+    }
+  }
+  ComputeUnbatched(ctx, done);
+}
+
+// Returns true if the call can join a micro-batch. The key identifies the
+// calls whose inputs only differ in the batch dim.
+bool NGraphEncapsulateOp::GetMicroBatchKey(OpKernelContext* ctx,
+                                           std::string& key, int64& rows) {
+  rows = -1;
+  key.clear();
+  for (int i = 0; i < ctx->num_inputs(); i++) {
+    const Tensor& input = ctx->input(i);
+    if (input.dims() == 0 || !DataTypeCanUseMemcpy(input.dtype())) {
+      return false;
+    }
+    if (rows == -1) {
+      rows = input.dim_size(0);
+    } else if (input.dim_size(0) != rows) {
+      return false;
+    }
+    key += to_string(input.dtype());
+    for (int d = 1; d < input.dims(); d++) {
+      key += "," + to_string(input.dim_size(d));
+    }
+    key += ";";
+  }
+  if (rows <= 0 || rows >= m_micro_batcher->GetMaxRows()) return false;
+  std::lock_guard<std::mutex> lock(m_micro_batch_mutex);
+  return m_unbatchable_keys.count(key) == 0;
 }
 
-void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
+// Runs the coalesced calls as one inference on their concatenated inputs,
+// and hands each call its rows of the outputs. The calls run one by one
+// when the batched executable is not available or its outputs do not scale
+// with the batch.
+void NGraphEncapsulateOp::RunMicroBatch(
+    const std::string& key, std::vector<MicroBatcher::Request> requests) {
+  if (requests.size() == 1) {
+    ComputeUnbatched(requests[0].ctx, requests[0].done);
+    return;
+  }
+  auto state = std::make_shared<MicroBatchState>();
+  state->requests = std::move(requests);
+  Status status = PrepareMicroBatch(key, *state);
+  if (status != Status::OK() || state->ng_exec == nullptr) {
+    OVTF_VLOG(2) << "Running " << state->requests.size() << " calls of cluster "
+                 << m_cluster_id
+                 << " one by one: " << status.error_message();
+    for (auto& request : state->requests) {
+      ComputeUnbatched(request.ctx, request.done);
+    }
+    return;
+  }
+
+  auto on_complete = [this, state](std::exception_ptr exp) {
+    Status status;
+    if (exp) {
+      string status_string = "Caught exception while executing cluster " +
+                             to_string(m_cluster_id);
+      try {
+        std::rethrow_exception(exp);
+      } catch (const std::exception& e) {
+        status_string += ": " + string(e.what());
+      } catch (...) {
+      }
+      status = errors::Internal(status_string);
+      if (NGraphClusterManager::IsClusterFallbackEnabled()) {
+        OVTF_VLOG(4) << status.error_message();
+        // The fallback runs a TF session, which must not hold up the thread
+        // of the inference callback
+        auto workers = state->requests[0]
+                           .ctx->device()
+                           ->tensorflow_cpu_worker_threads()
+                           ->workers;
+        workers->Schedule([this, state]() {
+          for (auto& request : state->requests) {
+            Status fallback_status = Fallback(request.ctx);
+            if (fallback_status != Status::OK()) {
+              request.ctx->SetStatus(fallback_status);
+            }
+          }
+          for (auto& request : state->requests) request.done();
+        });
+        return;
+      }
+    }
+    int64 row = 0;
+    for (auto& request : state->requests) {
+      OpKernelContext* ctx = request.ctx;
+      if (status != Status::OK()) {
+        ctx->SetStatus(status);
+        continue;
+      }
+      // Slices along dim 0 share the buffer, unaligned ones are copied
+      for (int i = 0; i < state->outputs.size(); i++) {
+        Tensor rows = state->outputs[i].Slice(row, row + request.rows);
+        if (!rows.IsAligned()) rows = tensor::DeepCopy(rows);
+        ctx->set_output(i, rows);
+      }
+      row += request.rows;
+    }
+    for (auto& request : state->requests) request.done();
+  };
+
+  try {
+    state->ng_exec->CallAsync(state->ng_inputs, state->ng_func_outputs,
+                              m_multi_req_execution, on_complete);
+  } catch (...) {
+    on_complete(std::current_exception());
+  }
+}
+
+// Concatenates the inputs of the calls, padded up to a power of two rows
+// within the micro-batch size so that a few executables serve all batches,
+// and allocates the batched outputs
+Status NGraphEncapsulateOp::PrepareMicroBatch(const std::string& key,
+                                              MicroBatchState& state) {
+  OpKernelContext* ctx = state.requests[0].ctx;
+  int64 rows = 0;
+  for (const auto& request : state.requests) rows += request.rows;
+  int64 padded_rows = 1;
+  while (padded_rows < rows) padded_rows <<= 1;
+  padded_rows =
+      std::max(rows, std::min(padded_rows, m_micro_batcher->GetMaxRows()));
+
+  state.inputs.resize(ctx->num_inputs());
+  for (int i = 0; i < ctx->num_inputs(); i++) {
+    TensorShape shape = ctx->input(i).shape();
+    shape.set_dim(0, padded_rows);
+    TF_RETURN_IF_ERROR(
+        ctx->allocate_temp(ctx->input_dtype(i), shape, &state.inputs[i]));
+    char* dst = const_cast<char*>(state.inputs[i].tensor_data().data());
+    size_t row_bytes = 0;
+    for (const auto& request : state.requests) {
+      auto src = request.ctx->input(i).tensor_data();
+      std::memcpy(dst, src.data(), src.size());
+      dst += src.size();
+      row_bytes = src.size() / request.rows;
+    }
+    // Repeat the last row in the padding
+    for (int64 row = rows; row < padded_rows; row++) {
+      std::memcpy(dst, dst - row_bytes, row_bytes);
+      dst += row_bytes;
+    }
+  }
+
+  TF_RETURN_IF_ERROR(GetExecutable(state.inputs, state.ng_exec));
+  // Still compiling in the background
+  if (state.ng_exec == nullptr) return Status::OK();
+
+  auto plan = state.ng_exec->GetExecutionPlan();
+  if (plan == nullptr) {
+    TF_RETURN_IF_ERROR(BuildExecutionPlan(ctx, *state.ng_exec, plan));
+    state.ng_exec->SetExecutionPlan(plan);
+  }
+  // Shapes that scale with the batch are not enough, the rows of the calls
+  // must not mix, see BatchAnalysis
+  bool batchable =
+      plan->device != "HDDL" && RowsAreIndependent(state.inputs);
+  for (const auto& output : plan->outputs) {
+    if (output.dynamic || output.zero_dim || output.tf_shape.dims() == 0 ||
+        output.tf_shape.dim_size(0) != padded_rows) {
+      batchable = false;
+    }
+  }
+  if (!batchable) {
+    std::lock_guard<std::mutex> lock(m_micro_batch_mutex);
+    m_unbatchable_keys.insert(key);
+    state.ng_exec = nullptr;
+    return errors::Unimplemented(
+        "The rows of the batch are not proven independent");
+  }
+
+  for (int i = 0; i < state.inputs.size(); i++) {
+    ov::Shape shape;
+    for (auto dim : state.inputs[i].shape().dim_sizes()) shape.push_back(dim);
+    state.ng_inputs.push_back(std::make_shared<IETensor>(
+        plan->input_types[i], shape,
+        const_cast<char*>(state.inputs[i].tensor_data().data())));
+  }
+  state.outputs.resize(plan->outputs.size());
+  state.ng_func_outputs.resize(plan->num_func_outputs, nullptr);
+  for (int i = 0; i < plan->outputs.size(); i++) {
+    const auto& output = plan->outputs[i];
+    TF_RETURN_IF_ERROR(ctx->allocate_temp(ctx->expected_output_dtype(i),
+                                          output.tf_shape, &state.outputs[i]));
+    ov::Shape shape;
+    for (auto dim : output.tf_shape.dim_sizes()) shape.push_back(dim);
+    state.ng_func_outputs[output.func_output] = std::make_shared<IETensor>(
+        output.element_type, shape,
+        const_cast<char*>(state.outputs[i].tensor_data().data()));
+  }
+  OVTF_VLOG(2) << "Micro-batched " << state.requests.size()
+               << " calls of cluster " << m_cluster_id << ", " << rows
+               << " rows padded to " << padded_rows;
+  ExecutionCounters::Increment(ExecutionCounters::kMicroBatches);
+  ExecutionCounters::Increment(ExecutionCounters::kMicroBatchedCalls,
+                               state.requests.size());
+  return Status::OK();
+}
+
+void NGraphEncapsulateOp::ComputeUnbatched(OpKernelContext* ctx,
+                                           DoneCallback done) {
   OVTF_VLOG(1) << "Compute using executor " << name();
   std::ostringstream oss;
   oss << "Execute: Encapsulate_" << m_cluster_id << ": " << name();
@@ -181,88 +669,125 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
                << m_cluster_id;
 
   if (NGraphClusterManager::CheckClusterFallback(m_cluster_id)) {
-    OP_REQUIRES_OK(ctx, Fallback(ctx));
+    OP_REQUIRES_OK_ASYNC(ctx, Fallback(ctx), done);
+    done();
     return;
   }
 
-  Timer compute_time;
-  std::lock_guard<std::mutex> lock(m_compute_lock_);
-  int time_func_create_or_lookup;
-  Timer function_lookup_or_create;
+  if (m_profile && SampleTF()) {
+    OP_REQUIRES_OK_ASYNC(ctx, RunFallbackSession(ctx), done);
+    done();
+    return;
+  }
 
-  bool multi_req_execution = false;
-  if (std::getenv("OPENVINO_TF_ENABLE_BATCHING")) {
-    OVTF_VLOG(2) << "Batching is enabled" << name();
-    multi_req_execution = true;
+  auto state = std::make_shared<ExecutionState>();
+  // The signature of the backend selector keeps the full shapes, even when
+  // the executable is compiled with dynamic shapes
+  if (m_backend_selector != nullptr) {
+    std::vector<Tensor> inputs;
+    for (int i = 0; i < ctx->num_inputs(); i++) inputs.push_back(ctx->input(i));
+    if (state->backend_signature.Compute(inputs, m_input_is_static).ok() &&
+        m_backend_selector->Select(state->backend_signature,
+                                   state->sample_backend) ==
+            BackendSelector::Backend::kTF) {
+      Timer tf_time;
+      OP_REQUIRES_OK_ASYNC(ctx, RunFallbackSession(ctx), done);
+      if (state->sample_backend) {
+        m_backend_selector->Record(state->backend_signature,
+                                   BackendSelector::Backend::kTF,
+                                   tf_time.ElapsedInMicroSec());
+      }
+      done();
+      return;
+    }
   }
+  int time_func_create_or_lookup;
+  Timer function_lookup_or_create;
 
   // TF input tensor
   std::vector<Tensor> tf_input_tensors;
   std::shared_ptr<Executable> ng_exec;
-  int step_id;
   {
     for (int i = 0; i < ctx->num_inputs(); i++) {
       tf_input_tensors.push_back(ctx->input(i));
     }
 
-    step_id = ctx->step_id();
+    state->step_id = ctx->step_id();
+
+    if (m_batch_bucketing) {
+      OP_REQUIRES_OK_ASYNC(ctx, PadBatch(ctx, tf_input_tensors, *state), done);
+    }
 
     // Get ngraph executable and inputs information
     Status getex_status = GetExecutable(tf_input_tensors, ng_exec);
-    NGraphClusterManager::SetMRUExecutable(m_cluster_id, ng_exec);
     if (getex_status != Status::OK()) {
       if (NGraphClusterManager::IsClusterFallbackEnabled()) {
-        OP_REQUIRES_OK(ctx, Fallback(ctx));
+        OP_REQUIRES_OK_ASYNC(ctx, Fallback(ctx), done);
+        done();
         return;
       } else {
-        OP_REQUIRES_OK(ctx, getex_status);
+        OP_REQUIRES_OK_ASYNC(ctx, getex_status, done);
       }
     }
 
-    OVTF_VLOG(1) << " Step_ID: " << step_id;
+    if (ng_exec == nullptr) {
+      // The executable is compiling in the background, run this call on
+      // native TF meanwhile
+      OP_REQUIRES_OK_ASYNC(ctx, RunFallbackSession(ctx), done);
+      done();
+      return;
+    }
+
+    OVTF_VLOG(1) << " Step_ID: " << state->step_id;
     OVTF_VLOG(4)
         << "NGraphEncapsulateOp::Compute got ngraph executable for cluster "
         << m_cluster_id;
 
     time_func_create_or_lookup = function_lookup_or_create.ElapsedInMS();
   }
+  state->ng_exec = ng_exec;
+  state->plan = ng_exec->GetExecutionPlan();
+  if (state->plan == nullptr) {
+    OP_REQUIRES_OK_ASYNC(ctx, BuildExecutionPlan(ctx, *ng_exec, state->plan),
+                         done);
+    ng_exec->SetExecutionPlan(state->plan);
+  }
+  const ExecutionPlan& plan = *state->plan;
 
   OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got graph for cluster "
                << m_cluster_id;
 
   Timer create_or_lookup_tensors;
-  vector<shared_ptr<ov::Tensor>> ng_inputs;
-  int ng_input_tensor_size_in_bytes = 0;
   {
     // Allocate tensors for input arguments.
     for (int i = 0; i < tf_input_tensors.size(); i++) {
-      ov::Shape ng_shape(tf_input_tensors[i].shape().dims());
-      for (int j = 0; j < tf_input_tensors[i].shape().dims(); ++j) {
-        ng_shape[j] = tf_input_tensors[i].shape().dim_size(j);
-      }
-      auto check_ng_shape = [ng_shape]() {
-        if (ng_shape.size() > 0) {
-          for (auto dim : ng_shape) {
-            if (dim == 0) return true;
-          }
-        }
-        return false;
-      };
-      if (check_ng_shape()) continue;
-      ov::element::Type ng_element_type;
-      OP_REQUIRES_OK(ctx, util::TFDataTypeToNGraphElementType(
-                              tf_input_tensors[i].dtype(), &ng_element_type));
-
-      auto backend = BackendManager::GetBackend();
+      const TensorShape& tf_shape = tf_input_tensors[i].shape();
+      if (tf_shape.num_elements() == 0 && tf_shape.dims() > 0) continue;
+
+#if TF_MAJOR_VERSION >= 2
+      // Results of an upstream cluster that TF received without a copy are
+      // consumed as the OpenVINO tensors they alias
+      auto handoff = IETensorBuffer::GetAliasedTensor(tf_input_tensors[i],
+                                                      plan.input_types[i]);
+      if (handoff != nullptr) {
+        OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute input " << i
+                     << " handed off by an upstream cluster";
+        state->ng_inputs.push_back(handoff);
+        state->input_bytes += tf_input_tensors[i].TotalBytes();
+        continue;
+      }
+#endif
+
 #if TF_VERSION < 2
-      std::shared_ptr<ov::Tensor> ng_tensor =
-          make_shared<IETensor>(ng_element_type, ng_shape,
-                                (void*)DMAHelper::base(&tf_input_tensors[i]));
+      void* data = (void*)DMAHelper::base(&tf_input_tensors[i]);
 #else
-      std::shared_ptr<ov::Tensor> ng_tensor = make_shared<IETensor>(
-          ng_element_type, ng_shape, tf_input_tensors[i].data());
+      void* data = tf_input_tensors[i].data();
 #endif
-      ng_inputs.push_back(ng_tensor);
+      std::shared_ptr<ov::Tensor> ng_tensor =
+          ng_exec->GetInputTensorPool().Get(i, plan.input_types[i], tf_shape,
+                                            data);
+      state->ng_inputs.push_back(ng_tensor);
+      state->input_bytes += tf_input_tensors[i].TotalBytes();
     }
   }
 
@@ -271,82 +796,43 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
                << m_cluster_id;
 
   // Allocate tensors for the output results.
-
-  auto results = ng_exec->GetResults();
-  std::string device;
-  Status exec_status = BackendManager::GetBackendName(device);
-  if (exec_status != Status::OK()) {
-    throw runtime_error(exec_status.error_message());
-  }
-  auto backend = BackendManager::GetBackend();
-  auto dev_type = backend->GetDeviceType();
-  std::string precision = dev_type.substr(dev_type.find("_") + 1);
-  std::vector<shared_ptr<ov::Tensor>> ng_func_outputs(results.size(), nullptr);
-  std::vector<shared_ptr<ov::Tensor>> ng_outputs(ng_result_list.size(),
-                                                 nullptr);
-  std::vector<int> dyn_shape_tensors;
-  std::vector<int> output_mappings(ng_result_list.size(), -1);
-  auto ng_output_shapes = ng_exec->GetOutputShapes();
-  int j = 0;
-  if (device != "HDDL") {
-    for (auto i = 0; i < ng_result_list.size(); i++) {
-      auto ng_element = ng_result_list[i];
-      if (ng_element->get_output_partial_shape(0).is_dynamic()) {
-        OVTF_VLOG(4)
-            << "NGraphEncapsulateOp::Compute skipping output allocation for "
-               "dynamic tensor at index"
-            << i;
-        dyn_shape_tensors.push_back(i);
-        output_mappings[i] = j;
-        j++;
-        continue;
-      }
+  state->ng_func_outputs.resize(plan.num_func_outputs, nullptr);
+  if (plan.device != "HDDL") {
+    for (int i = 0; i < plan.outputs.size(); i++) {
+      const auto& output = plan.outputs[i];
+      if (output.dynamic) continue;
 
       // Create the TF output tensor
-      auto ng_shape = ng_output_shapes[i];
-      TensorShape tf_shape;
-      for (auto dim : ng_shape) {
-        tf_shape.AddDim(dim);
-      }
       Tensor* output_tensor = nullptr;
-      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
-
-      // Make sure the nGraph-inferred element type agrees with what TensorFlow
-      // expected
-      ov::element::Type expected_elem_type;
-      auto ng_element_type = ng_element->get_element_type();
-      if (ng_element_type == ov::element::Type_t::f16 && precision == "FP16")
-        ng_element_type = ov::element::Type_t::f32;
-      OP_REQUIRES_OK(ctx,
-                     util::TFDataTypeToNGraphElementType(
-                         ctx->expected_output_dtype(i), &expected_elem_type));
-      OP_REQUIRES(
-          ctx, ng_element_type == expected_elem_type,
-          errors::Internal("Element type inferred by nGraph does not match "
-                           "the element type expected by TensorFlow"));
+      if (state->padded_batch > 0) {
+        // The batch analysis proved that dim 0 of every output is the batch
+        OP_REQUIRES_ASYNC(
+            ctx,
+            output.tf_shape.dims() > 0 &&
+                output.tf_shape.dim_size(0) == state->padded_batch,
+            errors::Internal("Output ", i, " of cluster ", m_cluster_id,
+                             " does not have the padded batch"),
+            done);
+        output_tensor = &state->padded_outputs[i];
+        OP_REQUIRES_OK_ASYNC(
+            ctx, ctx->allocate_temp(ctx->expected_output_dtype(i),
+                                    output.tf_shape, output_tensor),
+            done);
+      } else {
+        OP_REQUIRES_OK_ASYNC(
+            ctx, ctx->allocate_output(i, output.tf_shape, &output_tensor),
+            done);
+      }
+      if (output.zero_dim) continue;
 
 #if TF_VERSION < 2
-      ng_outputs[i] = make_shared<IETensor>(
-          ng_element_type, ng_shape, (void*)DMAHelper::base(output_tensor));
-
+      void* data = (void*)DMAHelper::base(output_tensor);
 #else
-      ng_outputs[i] = make_shared<IETensor>(ng_element_type, ng_shape,
-                                            output_tensor->data());
+      void* data = output_tensor->data();
 #endif
-
-      auto check_ng_shape = [ng_shape]() {
-        if (ng_shape.size() > 0) {
-          for (auto dim : ng_shape) {
-            if (dim == 0) return true;
-          }
-        }
-        return false;
-      };
-
-      if (!(check_ng_shape())) {
-        output_mappings[i] = j;
-        ng_func_outputs[j++] = ng_outputs[i];
-      }
+      state->ng_func_outputs[output.func_output] =
+          ng_exec->GetOutputTensorPool().Get(i, output.element_type,
+                                             output.tf_shape, data);
     }
   }
   OVTF_VLOG(4)
@@ -354,280 +840,916 @@ void NGraphEncapsulateOp::Compute(OpKernelContext* ctx) {
       << m_cluster_id;
 
   int time_create_or_lookup_tensors = create_or_lookup_tensors.ElapsedInMS();
-  // Execute the nGraph function.
-  int time_execute_function;
-  {
-    Timer execute_function;
-    {
-      OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
-                   << m_cluster_id;
+  state->boundary_us = create_or_lookup_tensors.ElapsedInMicroSec();
+
+  // Execute the OpenVINO model. The inter-op thread is released while the
+  // inference runs; the outputs are handled and done() is called from the
+  // completion callback.
+  OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call starting for cluster "
+               << m_cluster_id;
+  auto on_complete = [this, ctx, state, done, time_func_create_or_lookup,
+                      time_create_or_lookup_tensors](std::exception_ptr exp) {
+    int time_execute_function = state->execute_function.ElapsedInMS();
+    if (exp) {
+      string status_string = "Caught exception while executing cluster " +
+                             to_string(m_cluster_id);
       try {
-        ng_exec->Call(ng_inputs, ng_func_outputs, multi_req_execution);
-      } catch (const std::exception& exp) {
-        string status_string = "Caught exception while executing cluster " +
-                               to_string(m_cluster_id) + ": " +
-                               string(exp.what());
-        if (NGraphClusterManager::IsClusterFallbackEnabled()) {
-          OVTF_VLOG(4) << status_string;
-          OP_REQUIRES_OK(ctx, Fallback(ctx));
-          return;
-        } else {
-          OP_REQUIRES(ctx, false, errors::Internal(status_string));
-        }
+        std::rethrow_exception(exp);
+      } catch (const std::exception& e) {
+        status_string += ": " + string(e.what());
       } catch (...) {
-        string status_string = "Caught exception while executing cluster " +
-                               to_string(m_cluster_id);
-        if (NGraphClusterManager::IsClusterFallbackEnabled()) {
-          OVTF_VLOG(4) << status_string;
-          OP_REQUIRES_OK(ctx, Fallback(ctx));
-          return;
-        } else {
-          OP_REQUIRES(ctx, false, errors::Internal(status_string));
-        }
       }
+      if (NGraphClusterManager::IsClusterFallbackEnabled()) {
+        OVTF_VLOG(4) << status_string;
+        // The fallback runs a TF session, which must not hold up the thread
+        // of the inference callback
+        auto workers = ctx->device()->tensorflow_cpu_worker_threads()->workers;
+        workers->Schedule([this, ctx, done]() {
+          OP_REQUIRES_OK_ASYNC(ctx, Fallback(ctx), done);
+          done();
+        });
+        return;
+      }
+      ctx->SetStatus(errors::Internal(status_string));
+      done();
+      return;
     }
-    time_execute_function = execute_function.ElapsedInMS();
-  }
 
-  if (device != "HDDL") {
-    for (auto i : dyn_shape_tensors) {
-      OP_REQUIRES(ctx, output_mappings[i] != -1,
-                  errors::Internal("Mapping error while "
-                                   "reading dynamic output blob"));
-      auto ng_output = ng_func_outputs[output_mappings[i]];
-      // Create the TF output tensor
-      auto ng_shape = ng_output->get_shape();
-      TensorShape tf_shape;
-      for (auto dim : ng_shape) {
-        tf_shape.AddDim(dim);
-      }
+    Timer process_outputs;
+    OP_REQUIRES_OK_ASYNC(ctx, ProcessOutputs(ctx, *state), done);
+    // Drop the padded rows, slices along dim 0 share the buffer
+    for (auto& padded_output : state->padded_outputs) {
+      ctx->set_output(padded_output.first,
+                      padded_output.second.Slice(0, state->batch));
+    }
+    if (m_profile) {
+      ClusterProfile::RecordExecution(
+          m_profile_fingerprint, state->execute_function.ElapsedInMicroSec(),
+          state->boundary_us + process_outputs.ElapsedInMicroSec());
+    }
+    // The compilation is not part of the time of the call
+    if (state->sample_backend) {
+      m_backend_selector->Record(
+          state->backend_signature, BackendSelector::Backend::kOpenVINO,
+          state->execute_function.ElapsedInMicroSec() + state->boundary_us +
+              process_outputs.ElapsedInMicroSec());
+    }
 
-      // TODO: Zero-copy is depreciated temporarily because of memory allocation
-      // alignment
-      // mismatch related to EIGEN_MAX_ALIGN_BYTES.
-      Tensor* output_tensor = nullptr;
-      OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
+    if (OVTF_VLOG_IS_ON(1)) {
+      long vm = 0, rss = 0;
+      util::MemoryProfile(vm, rss);
+      OVTF_VLOG(1) << "OPENVINO_TF_MEM_PROFILE:  OP_ID: " << m_cluster_id
+                   << " Step_ID: " << state->step_id << " Cluster: " << name()
+                   << " Input Tensors created: "
+                   << state->input_bytes / (1024 * 1024) << " MB"
+                   << " Total process memory: " << rss / (1024 * 1024)
+                   << " GB";
+    }
+
+    OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call done for cluster "
+                 << m_cluster_id;
+
+    OVTF_VLOG(4)
+        << "NGraphEncapsulateOp::Compute done marking fresh for cluster "
+        << m_cluster_id;
+    OVTF_VLOG(1) << "OPENVINO_TF_TIMING_PROFILE: OP_ID: " << m_cluster_id
+                 << " Step_ID: " << state->step_id << " Cluster: " << name()
+                 << " Time-Compute: " << state->compute_time.ElapsedInMS()
+                 << " Function-Create-or-Lookup: " << time_func_create_or_lookup
+                 << " Create-and-copy-tensors: "
+                 << time_create_or_lookup_tensors
+                 << " Execute: " << time_execute_function
+                 << " Signature-Total-us: " << m_signature_time_ns / 1000
+                 << " Signature-Calls: " << m_signature_count;
+    done();
+  };
+
+  state->execute_function.Reset();
+  try {
+    ng_exec->CallAsync(state->ng_inputs, state->ng_func_outputs,
+                       m_multi_req_execution, on_complete);
+  } catch (...) {
+    on_complete(std::current_exception());
+  }
+}  // end compute
 
-      auto size = ng_output->get_byte_size();
-      auto ie_tensor = static_pointer_cast<IETensor>(ng_output);
+// Copies the dynamic results of a finished execution into the TF outputs
+// Hands an OpenVINO result to TF as output i. The memory of the result is
+// aliased when it is suitably aligned, and copied otherwise. tf_shape may
+// keep only the leading rows of the result.
+Status NGraphEncapsulateOp::SetOutputTensor(
+    OpKernelContext* ctx, int i, const TensorShape& tf_shape,
+    const std::shared_ptr<ov::Tensor>& ng_output) {
+#if TF_MAJOR_VERSION >= 2
+  DataType dtype = ctx->expected_output_dtype(i);
+  TensorShape ng_tf_shape;
+  for (auto dim : ng_output->get_shape()) {
+    ng_tf_shape.AddDim(dim);
+  }
+  TensorShape rows_shape = ng_tf_shape;
+  if (tf_shape.dims() > 0 && ng_tf_shape.dims() == tf_shape.dims() &&
+      tf_shape.dim_size(0) <= ng_tf_shape.dim_size(0)) {
+    rows_shape.set_dim(0, tf_shape.dim_size(0));
+  }
+  if (rows_shape == tf_shape &&
+      ng_tf_shape.num_elements() * DataTypeSize(dtype) ==
+          ng_output->get_byte_size() &&
+      IETensorBuffer::CanAlias(*ng_output, dtype)) {
+    auto buffer = new IETensorBuffer(ng_output);
+    Tensor output_tensor(dtype, ng_tf_shape, buffer);
+    buffer->Unref();
+    if (tf_shape == ng_tf_shape) {
+      ctx->set_output(i, output_tensor);
+    } else {
+      ctx->set_output(i, output_tensor.Slice(0, tf_shape.dim_size(0)));
+    }
+    return Status::OK();
+  }
+#endif
 
+  Tensor* output_tensor = nullptr;
+  TF_RETURN_IF_ERROR(ctx->allocate_output(i, tf_shape, &output_tensor));
+  auto size = std::min(ng_output->get_byte_size(),
+                       static_cast<size_t>(output_tensor->TotalBytes()));
 #if TF_VERSION < 2
-      std::copy((uint8_t*)(ng_output->data()),
-                ((uint8_t*)(ng_output->data())) + size,
-                (uint8_t**)DMAHelper::base(output_tensor));
+  std::copy((uint8_t*)(ng_output->data()),
+            ((uint8_t*)(ng_output->data())) + size,
+            (uint8_t**)DMAHelper::base(output_tensor));
 #else
-      std::copy((uint8_t*)(ng_output->data()),
-                ((uint8_t*)(ng_output->data())) + size,
-                (uint8_t*)(output_tensor->data()));
+  std::copy((uint8_t*)(ng_output->data()),
+            ((uint8_t*)(ng_output->data())) + size,
+            (uint8_t*)(output_tensor->data()));
 #endif
+  return Status::OK();
+}
+
+// Resolves everything Compute needs that only depends on the executable:
+// the device, the element types, the static output shapes and where each
+// output is found among the outputs of the compiled model.
+Status NGraphEncapsulateOp::BuildExecutionPlan(
+    OpKernelContext* ctx, Executable& ng_exec,
+    std::shared_ptr<const ExecutionPlan>& plan) {
+  auto new_plan = std::make_shared<ExecutionPlan>();
+  TF_RETURN_IF_ERROR(BackendManager::GetBackendName(new_plan->device));
+  auto dev_type = BackendManager::GetBackend()->GetDeviceType();
+  std::string precision = dev_type.substr(dev_type.find("_") + 1);
+
+  new_plan->input_types.resize(ctx->num_inputs());
+  for (int i = 0; i < ctx->num_inputs(); i++) {
+    TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+        ctx->input_dtype(i), &new_plan->input_types[i]));
+  }
+
+  const auto& ng_result_list = ng_exec.GetResultList();
+  auto ng_output_shapes = ng_exec.GetOutputShapes();
+  new_plan->num_func_outputs = ng_exec.GetResults().size();
+  new_plan->outputs.resize(ng_result_list.size());
+  int j = 0;
+  for (int i = 0; i < ng_result_list.size(); i++) {
+    auto& output = new_plan->outputs[i];
+    output.dynamic = ng_result_list[i]->get_output_partial_shape(0).is_dynamic();
+    if (output.dynamic) {
+      OVTF_VLOG(4) << "NGraphEncapsulateOp: output " << i
+                   << " is dynamic, it is allocated after the inference";
+      new_plan->dynamic_outputs.push_back(i);
+    } else {
+      for (auto dim : ng_output_shapes[i]) {
+        output.tf_shape.AddDim(dim);
+        if (dim == 0) output.zero_dim = true;
+      }
     }
-  } else {
-    auto out_shape_check = [ng_output_shapes](int i) {
-      if (ng_output_shapes[i].size() > 0) {
-        auto out_shape_list = ng_output_shapes[i];
-        for (auto dim : out_shape_list) {
-          if (dim == 0) return true;
-        }
+    if (!output.zero_dim) output.func_output = j++;
+
+    // Make sure the nGraph-inferred element type agrees with what TensorFlow
+    // expected
+    output.element_type = ng_result_list[i]->get_element_type();
+    if (output.dynamic && new_plan->device != "HDDL") continue;
+    if (output.element_type == ov::element::Type_t::f16 &&
+        precision == "FP16")
+      output.element_type = ov::element::Type_t::f32;
+    ov::element::Type expected_elem_type;
+    TF_RETURN_IF_ERROR(util::TFDataTypeToNGraphElementType(
+        ctx->expected_output_dtype(i), &expected_elem_type));
+    if (output.element_type != expected_elem_type) {
+      return errors::Internal(
+          "Element type inferred by nGraph does not match "
+          "the element type expected by TensorFlow");
+    }
+  }
+  plan = new_plan;
+  return Status::OK();
+}
+
+Status NGraphEncapsulateOp::ProcessOutputs(OpKernelContext* ctx,
+                                           ExecutionState& state) {
+  const ExecutionPlan& plan = *state.plan;
+  auto& ng_func_outputs = state.ng_func_outputs;
+  if (plan.device != "HDDL") {
+    for (auto i : plan.dynamic_outputs) {
+      auto ng_output = ng_func_outputs[plan.outputs[i].func_output];
+      if (ng_output == nullptr) {
+        return errors::Internal(
+            "Mapping error while "
+            "reading dynamic output blob");
       }
-      return false;
-    };
-    int j = 0;
-    for (int i = 0; i < ng_result_list.size(); i++) {
-      if (out_shape_check(i)) {
-        auto ng_shape = ng_output_shapes[i];
-        ov::element::Type expected_elem_type;
-        auto ng_element = ng_result_list[i];
-        auto ng_element_type = ng_element->get_element_type();
-        OP_REQUIRES_OK(ctx,
-                       util::TFDataTypeToNGraphElementType(
-                           ctx->expected_output_dtype(i), &expected_elem_type));
-        OP_REQUIRES(
-            ctx, ng_element_type == expected_elem_type,
-            errors::Internal("Element type inferred by nGraph does not match "
-                             "the element type expected by TensorFlow"));
-        TensorShape tf_shape;
-        for (auto dim : ng_shape) {
-          tf_shape.AddDim(dim);
+      // Create the TF output tensor
+      TensorShape tf_shape;
+      for (auto dim : ng_output->get_shape()) {
+        tf_shape.AddDim(dim);
+      }
+      // Keep only the real rows of a padded batch, they come first
+      if (state.padded_batch > 0) {
+        if (tf_shape.dims() == 0 ||
+            tf_shape.dim_size(0) != state.padded_batch) {
+          return errors::Internal("Output ", i, " of cluster ", m_cluster_id,
+                                  " does not have the padded batch");
         }
+        tf_shape.set_dim(0, state.batch);
+      }
 
+      TF_RETURN_IF_ERROR(SetOutputTensor(ctx, i, tf_shape, ng_output));
+    }
+  } else {
+    for (int i = 0; i < plan.outputs.size(); i++) {
+      const auto& output = plan.outputs[i];
+      if (output.zero_dim) {
         Tensor* output_tensor = nullptr;
-        OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
-      } else {
-        auto ng_output = ng_func_outputs[j++];
-
-        auto ng_shape = ng_output_shapes[i];
-        if (ng_result_list[i]->is_dynamic()) {
-          ng_shape = ng_output->get_shape();
-        }
-        ov::element::Type expected_elem_type;
-        auto ng_element = ng_result_list[i];
-        auto ng_element_type = ng_element->get_element_type();
-        OP_REQUIRES_OK(ctx,
-                       util::TFDataTypeToNGraphElementType(
-                           ctx->expected_output_dtype(i), &expected_elem_type));
-        OP_REQUIRES(
-            ctx, ng_element_type == expected_elem_type,
-            errors::Internal("Element type inferred by nGraph does not match "
-                             "the element type expected by TensorFlow"));
-        TensorShape tf_shape;
-        for (auto dim : ng_shape) {
+        TF_RETURN_IF_ERROR(
+            ctx->allocate_output(i, output.tf_shape, &output_tensor));
+        continue;
+      }
+      auto ng_output = ng_func_outputs[output.func_output];
+      TensorShape tf_shape = output.tf_shape;
+      if (output.dynamic) {
+        tf_shape = TensorShape();
+        for (auto dim : ng_output->get_shape()) {
           tf_shape.AddDim(dim);
         }
+      }
+      TF_RETURN_IF_ERROR(SetOutputTensor(ctx, i, tf_shape, ng_output));
+    }
+  }
+  return Status::OK();
+}
 
-        Tensor* output_tensor = nullptr;
-        OP_REQUIRES_OK(ctx, ctx->allocate_output(i, tf_shape, &output_tensor));
+// Pads the batch dim of the non-static inputs up to the next power of two so
+// that varying batch sizes share a few executables. The padding repeats the
+// last row. Inputs are left unchanged unless all non-static inputs have the
+// same dim 0 and the batch analysis proved that the rows are independent,
+// which the first unpadded translation for the static input values runs.
+Status NGraphEncapsulateOp::PadBatch(OpKernelContext* ctx,
+                                     std::vector<Tensor>& tf_input_tensors,
+                                     ExecutionState& state) {
+  int64 batch = -1;
+  for (int i = 0; i < tf_input_tensors.size(); i++) {
+    if (m_input_is_static[i]) continue;
+    const Tensor& input = tf_input_tensors[i];
+    if (input.dims() == 0 || !DataTypeCanUseMemcpy(input.dtype())) {
+      return Status::OK();
+    }
+    if (batch == -1) {
+      batch = input.dim_size(0);
+    } else if (input.dim_size(0) != batch) {
+      return Status::OK();
+    }
+  }
+  if (batch <= 0) return Status::OK();
+  int64 padded_batch = 1;
+  while (padded_batch < batch) padded_batch <<= 1;
+  if (padded_batch == batch) return Status::OK();
+  if (!RowsAreIndependent(tf_input_tensors)) return Status::OK();
 
-        auto size = ng_output->get_byte_size();
-        auto ie_tensor = static_pointer_cast<IETensor>(ng_output);
+  for (int i = 0; i < tf_input_tensors.size(); i++) {
+    if (m_input_is_static[i]) continue;
+    const Tensor& input = tf_input_tensors[i];
+    TensorShape padded_shape = input.shape();
+    padded_shape.set_dim(0, padded_batch);
+    Tensor padded;
+    TF_RETURN_IF_ERROR(
+        ctx->allocate_temp(input.dtype(), padded_shape, &padded));
+    auto src = input.tensor_data();
+    char* dst = const_cast<char*>(padded.tensor_data().data());
+    size_t row_bytes = src.size() / batch;
+    std::memcpy(dst, src.data(), src.size());
+    for (int64 row = batch; row < padded_batch; row++) {
+      std::memcpy(dst + row * row_bytes, src.data() + (batch - 1) * row_bytes,
+                  row_bytes);
+    }
+    tf_input_tensors[i] = padded;
+  }
+  state.batch = batch;
+  state.padded_batch = padded_batch;
+  OVTF_VLOG(4) << "Padded batch " << batch << " to " << padded_batch
+               << " for cluster " << m_cluster_id;
+  return Status::OK();
+}
 
-#if TF_VERSION < 2
-        std::copy((uint8_t*)(ng_output->data()),
-                  ((uint8_t*)(ng_output->data())) + size,
-                  (uint8_t**)DMAHelper::base(output_tensor));
-#else
-        std::copy((uint8_t*)(ng_output->data()),
-                  ((uint8_t*)(ng_output->data())) + size,
-                  (uint8_t*)(output_tensor->data()));
-#endif
+// Computes signature and gets executable. With background compilation
+// enabled, a cache miss queues the compilation and returns a null executable.
+Status NGraphEncapsulateOp::GetExecutable(
+    const std::vector<Tensor>& tf_input_tensors,
+    std::shared_ptr<Executable>& ng_exec) {
+  std::unique_lock<std::mutex> lock(m_exec_cache_mutex);
+
+  // A failed dynamic shape compilation is retried once with static shapes,
+  // and a lookup is repeated once a queued compilation of it has finished
+  while (true) {
+    bool dynamic = UseDynamicShapes(tf_input_tensors);
+    const std::vector<bool>& input_is_dynamic =
+        dynamic ? m_input_is_dynamic : kNoDynamicInputs;
+
+    // Compute Signature. When the inputs repeat the previous call the last
+    // signature is reused without building a new one.
+    auto signature_start = std::chrono::steady_clock::now();
+    const InputSignature* signature = &m_last_signature;
+    InputSignature computed_signature;
+    bool reused_signature = m_last_signature.Matches(
+        tf_input_tensors, m_input_is_static, input_is_dynamic);
+    if (!reused_signature) {
+      TF_RETURN_IF_ERROR(computed_signature.Compute(
+          tf_input_tensors, m_input_is_static, input_is_dynamic));
+      signature = &computed_signature;
+    }
+    bool cached = ExecutableCache::Lookup(this, *signature, ng_exec);
+    auto signature_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - signature_start)
+            .count();
+    m_signature_time_ns += signature_ns;
+    m_signature_count++;
+    OVTF_VLOG(5) << "Computed signature: " << signature->DebugString()
+                 << (reused_signature ? " reused" : " built") << " in "
+                 << signature_ns << " ns";
+    OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got inputs for cluster "
+                 << m_cluster_id;
+
+    if (!cached) {
+      if (CompileScheduler::IsBackgroundCompileEnabled()) {
+        auto failed = m_failed_signatures.find(*signature);
+        if (failed != m_failed_signatures.end()) {
+          return failed->second;
+        }
+        OVTF_VLOG(1) << "Compilation cache miss, compiling in the background: "
+                     << m_name;
+        SubmitCompilation(tf_input_tensors, *signature, dynamic);
+        if (!reused_signature) {
+          m_last_signature = std::move(computed_signature);
+        }
+        ng_exec = nullptr;
+        return Status::OK();
       }
+
+      // A compilation of the signature queued by the warmup is waited for
+      // instead of compiling it again
+      std::string job_key = GetJobKey(*signature);
+      if (CompileScheduler::Get().IsInFlight(job_key)) {
+        OVTF_VLOG(1) << "Waiting for the queued compilation of " << m_name;
+        lock.unlock();
+        CompileScheduler::Get().Wait(job_key);
+        lock.lock();
+        continue;
+      }
+      // So is the compilation started by a concurrent call
+      if (m_compiling.count(*signature) > 0) {
+        OVTF_VLOG(1) << "Waiting for the concurrent compilation of " << m_name;
+        InputSignature waited_signature = *signature;
+        m_compiled_cv.wait(lock, [this, &waited_signature]() {
+          return m_compiling.count(waited_signature) == 0;
+        });
+        continue;
+      }
+      api::CompileProperties compile_properties = GetCompileProperties();
+      std::string model_cache_key =
+          GetModelCacheKey(*signature, compile_properties);
+      size_t cache_depth = GetCacheDepth();
+
+      // The lock is released while compiling, so that the calls with other
+      // signatures go on. m_last_signature may change meanwhile.
+      InputSignature compiling_signature = *signature;
+      m_compiling.insert(compiling_signature);
+      lock.unlock();
+      // Evict before compiling so the memory of the evicted executable can be
+      // reused
+      ExecutableCache::MakeRoom(this, cache_depth);
+      Status status = BuildExecutable(tf_input_tensors, dynamic,
+                                      compile_properties, model_cache_key,
+                                      ng_exec);
+      // Measured before locking, it walks the constants of the model
+      if (status.ok()) ng_exec->GetSizeBytes();
+      lock.lock();
+      m_compiling.erase(compiling_signature);
+      m_compiled_cv.notify_all();
+
+      if (!status.ok() && dynamic) {
+        OVTF_VLOG(1) << "Dynamic shape compilation failed for " << m_name
+                     << ", using static shapes: " << status.error_message();
+        m_dynamic_shapes_unsupported = true;
+        continue;
+      }
+      TF_RETURN_IF_ERROR(status);
+      InsertExecutable(compiling_signature, ng_exec);
+    }  // end of input signature not found in the executable cache
+    if (!reused_signature) {
+      m_last_signature = std::move(computed_signature);
     }
+    break;
   }
+  NGraphClusterManager::SetMRUExecutable(m_cluster_id, ng_exec);
+  return Status::OK();
+}
 
-  long vm = 0, rss = 0;
-  util::MemoryProfile(vm, rss);
-  OVTF_VLOG(1) << "OPENVINO_TF_MEM_PROFILE:  OP_ID: " << m_cluster_id
-               << " Step_ID: " << step_id << " Cluster: " << name()
-               << " Input Tensors created: "
-               << ng_input_tensor_size_in_bytes / (1024 * 1024) << " MB"
-               << " Total process memory: " << rss / (1024 * 1024) << " GB";
+// The properties are read for every compilation, so the ones set through
+// the API after the kernel was created apply to its later compilations
+api::CompileProperties NGraphEncapsulateOp::GetCompileProperties() const {
+  api::CompileProperties compile_properties = api::GetCompileProperties();
+  for (const auto& property : m_graph_compile_properties) {
+    compile_properties[property.first] = property.second;
+  }
+  return compile_properties;
+}
 
-  OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute call done for cluster "
-               << m_cluster_id;
+// Key of the model cache entry of the signature, empty if the model cache is
+// disabled. Requires m_exec_cache_mutex.
+std::string NGraphEncapsulateOp::GetModelCacheKey(
+    const InputSignature& signature,
+    const api::CompileProperties& compile_properties) {
+  if (!ModelCache::IsEnabled()) return "";
+  if (!m_graph_fingerprint_valid) {
+    std::shared_ptr<Graph> graph;
+    if (GetGraph(graph) != Status::OK()) return "";
+    m_graph_fingerprint = ModelCache::GraphFingerprint(*graph);
+    m_graph_fingerprint_valid = true;
+  }
+  // Models compiled with other properties are not interchangeable
+  std::string device = BackendManager::GetBackend()->GetDeviceType();
+  for (const auto& property : compile_properties) {
+    device += "/" + property.first + "=" + property.second;
+  }
+  return ModelCache::MakeKey(m_graph_fingerprint, signature, device);
+}
 
-  OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute done marking fresh for cluster "
-               << m_cluster_id;
-  OVTF_VLOG(1) << "OPENVINO_TF_TIMING_PROFILE: OP_ID: " << m_cluster_id
-               << " Step_ID: " << step_id << " Cluster: " << name()
-               << " Time-Compute: " << compute_time.ElapsedInMS()
-               << " Function-Create-or-Lookup: " << time_func_create_or_lookup
-               << " Create-and-copy-tensors: " << time_create_or_lookup_tensors
-               << " Execute: " << time_execute_function;
-}  // end compute
+// Key deduplicating the compilations of the signature on the CompileScheduler
+std::string NGraphEncapsulateOp::GetJobKey(const InputSignature& signature) {
+  return "cluster_" + to_string(m_cluster_id) + "/" + signature.Bytes();
+}
 
-// Computes signature and gets executable
-Status NGraphEncapsulateOp::GetExecutable(
+// Queues the compilation of the signature on the CompileScheduler. The
+// executable is inserted into the executable cache once compiled, failures
+// are reported by later calls with the signature. Requires
+// m_exec_cache_mutex.
+CompileScheduler::SubmitResult NGraphEncapsulateOp::SubmitCompilation(
     const std::vector<Tensor>& tf_input_tensors,
-    std::shared_ptr<Executable>& ng_exec) {
-  auto backend = BackendManager::GetBackend();
+    const InputSignature& signature, bool dynamic,
+    std::shared_ptr<WarmupRegistry::PendingCompilation> pending) {
+  api::CompileProperties compile_properties = GetCompileProperties();
+  std::string model_cache_key = GetModelCacheKey(signature, compile_properties);
+  return CompileScheduler::Get().Submit(
+      this, GetJobKey(signature),
+      [this, tf_input_tensors, signature, dynamic, compile_properties,
+       model_cache_key, pending]() {
+        std::shared_ptr<Executable> built_ng_exec;
+        Status status =
+            BuildExecutable(tf_input_tensors, dynamic, compile_properties,
+                            model_cache_key, built_ng_exec);
+        // Measured before locking, it walks the constants of the model
+        if (status.ok()) built_ng_exec->GetSizeBytes();
+        std::lock_guard<std::mutex> lock(m_exec_cache_mutex);
+        if (!status.ok()) {
+          OVTF_VLOG(0) << "Background compilation failed for " << m_name
+                       << ": " << status.error_message();
+          if (dynamic) {
+            m_dynamic_shapes_unsupported = true;
+          } else {
+            m_failed_signatures[signature] = status;
+          }
+          return status;
+        }
+        InsertExecutable(signature, built_ng_exec);
+        return Status::OK();
+      });
+}
 
-  // Compute Signature
-  std::vector<const Tensor*> static_input_map;
-  std::vector<TensorShape> input_shapes;
-  std::stringstream signature_ss;
+// Queues the compilation of the input shapes declared through api::Warmup,
+// or fixed by the graph, for this cluster. Clusters with static inputs are
+// skipped since their values are not known ahead of time.
+void NGraphEncapsulateOp::QueueWarmup(
+    OpKernelConstruction* ctx,
+    const std::vector<PartialTensorShape>& warmup_shapes) {
+  int num_inputs = ctx->num_inputs();
+  int64 num_signatures =
+      num_inputs == 0 ? 0 : warmup_shapes.size() / num_inputs;
+  bool has_static_inputs =
+      std::find(m_input_is_static.begin(), m_input_is_static.end(), true) !=
+      m_input_is_static.end();
+  if (num_inputs != m_input_is_static.size() || has_static_inputs ||
+      util::GetEnv("OPENVINO_TF_CONVERT_VARIABLES_TO_CONSTANTS") == "1") {
+    OVTF_VLOG(1) << "Cluster " << m_name
+                 << " depends on input values, it is not compiled ahead";
+    return;
+  }
+
+  // Only the kernels that are created count, encapsulate nodes pruned from
+  // the executed graph do not hold up the warmup
+  WarmupRegistry::CompilationsQueued(num_signatures);
+  std::lock_guard<std::mutex> lock(m_exec_cache_mutex);
+  for (int64 k = 0; k < num_signatures; k++) {
+    auto pending = std::make_shared<WarmupRegistry::PendingCompilation>();
+    std::vector<Tensor> tf_input_tensors;
+    for (int i = 0; i < num_inputs; i++) {
+      TensorShape shape;
+      if (!warmup_shapes[k * num_inputs + i].AsTensorShape(&shape)) {
+        tf_input_tensors.clear();
+        break;
+      }
+      tf_input_tensors.emplace_back(ctx->input_type(i), shape);
+    }
+    if (tf_input_tensors.empty()) continue;
+
+    bool dynamic = UseDynamicShapes(tf_input_tensors);
+    InputSignature signature;
+    if (!signature
+             .Compute(tf_input_tensors, m_input_is_static,
+                      dynamic ? m_input_is_dynamic : kNoDynamicInputs)
+             .ok()) {
+      continue;
+    }
+    OVTF_VLOG(1) << "Compiling " << m_name
+                 << " ahead: " << signature.DebugString();
+    SubmitCompilation(tf_input_tensors, signature, dynamic, pending);
+  }
+}
+
+// Dynamic shapes are used unless the cluster failed to compile with them or
+// a dynamic input has a zero dim, such inputs are not passed to the model.
+// Requires m_exec_cache_mutex.
+bool NGraphEncapsulateOp::UseDynamicShapes(
+    const std::vector<Tensor>& tf_input_tensors) {
+  if (!m_dynamic_shapes || m_dynamic_shapes_unsupported) return false;
   for (int i = 0; i < tf_input_tensors.size(); i++) {
-    const Tensor& input_tensor = tf_input_tensors[i];
-    input_shapes.push_back(input_tensor.shape());
-    for (const auto& x : input_tensor.shape()) {
-      signature_ss << x.size << ",";
+    if (!m_input_is_dynamic[i]) continue;
+    for (const auto& dim : tf_input_tensors[i].shape()) {
+      if (dim.size == 0) return false;
+    }
+  }
+  return true;
+}
+
+// Loads the executable from the model cache, or translates and compiles it.
+// Does not touch the executable cache, so it can run without holding
+// m_exec_cache_mutex.
+Status NGraphEncapsulateOp::BuildExecutable(
+    const std::vector<Tensor>& tf_input_tensors, bool dynamic,
+    const api::CompileProperties& compile_properties,
+    const std::string& model_cache_key, std::shared_ptr<Executable>& ng_exec) {
+  Timer compile_time;
+  // A model compiled by an earlier process skips both the translation and
+  // the compilation
+  if (!model_cache_key.empty()) {
+    ng_exec = ModelCache::Load(model_cache_key);
+    if (ng_exec != nullptr) {
+      AnalyzeRows(tf_input_tensors, nullptr);
+      if (m_profile) {
+        ClusterProfile::RecordCompile(m_profile_fingerprint,
+                                      compile_time.ElapsedInMicroSec());
+      }
+      return Status::OK();
     }
-    signature_ss << ";";
   }
-  signature_ss << "/";
 
-  static_input_map.resize(tf_input_tensors.size());
+  std::vector<const Tensor*> static_input_map(tf_input_tensors.size());
+  std::vector<TensorShape> input_shapes;
   for (int i = 0; i < tf_input_tensors.size(); i++) {
+    input_shapes.push_back(tf_input_tensors[i].shape());
     if (m_input_is_static[i]) {
       static_input_map[i] = &tf_input_tensors[i];
-      TF_RETURN_IF_ERROR(
-          util::TensorToStream(signature_ss, tf_input_tensors[i]));
-      signature_ss << ";";
     }
   }
 
-  string signature = signature_ss.str();
-  OVTF_VLOG(5) << "Computed signature: " << signature;
-  auto it = m_ng_exec_map.find(signature);
-  OVTF_VLOG(4) << "NGraphEncapsulateOp::Compute got inputs for cluster "
-               << m_cluster_id;
-
-  // Translate the TensorFlow graph to nGraph.
+  // Translate the TensorFlow graph to nGraph, unless a model translated for
+  // the same static input values can be reshaped
   std::shared_ptr<ov::Model> ng_function;
-  if (it == m_ng_exec_map.end()) {
-    // Measure the current total memory usage
-    long vm = 0, rss = 0, vm0 = 0, rss0 = 0;
-    util::MemoryProfile(vm0, rss0);
-
-    ng_result_list.clear();
-    OVTF_VLOG(1) << "Compilation cache miss: " << m_name;
+  ov::ResultVector ng_result_list;
+  OVTF_VLOG(1) << "Compilation cache miss: " << m_name;
+  if (m_model_templates_enabled) {
+    ng_function = SpecializeModelTemplate(tf_input_tensors, input_shapes,
+                                          static_input_map, dynamic);
+  }
+  if (ng_function != nullptr) {
+    ng_result_list = ng_function->get_results();
+  } else {
+    std::shared_ptr<Graph> graph;
+    TF_RETURN_IF_ERROR(GetGraph(graph));
     TF_RETURN_IF_ERROR(Builder::TranslateGraph(
-        input_shapes, static_input_map, &m_graph, m_name, ng_function,
-        ng_result_list, tf_input_tensors));
-    util::DumpNGGraph(ng_function, m_name);
-
-    std::vector<ov::Shape> ng_output_shapes;
-    ng_output_shapes.resize(ng_result_list.size());
-    for (int i = 0; i < ng_result_list.size(); i++) {
-      if (ng_result_list[i]->is_dynamic()) {
-        ng_output_shapes[i] = ov::Shape{};
-      } else {
-        ng_output_shapes[i] = ng_result_list[i]->get_shape();
-      }
-    }
-
-    // Evict the cache if the number of elements exceeds the limit
-    std::shared_ptr<Executable> evicted_ng_exec;
-    const char* cache_depth_specified =
-        std::getenv("OPENVINO_TF_FUNCTION_CACHE_ITEM_DEPTH");
-    if (cache_depth_specified != nullptr) {
-      m_function_cache_depth_in_items =
-          (int)strtol(cache_depth_specified, NULL, 10);
+        input_shapes, static_input_map, graph.get(), m_name, ng_function,
+        ng_result_list, tf_input_tensors,
+        dynamic ? m_input_is_dynamic : kNoDynamicInputs));
+    if (m_lean) ReleaseGraph();
+  }
+  util::DumpNGGraph(ng_function, m_name);
+  AnalyzeRows(tf_input_tensors, ng_function);
+
+  std::vector<ov::Shape> ng_output_shapes;
+  ng_output_shapes.resize(ng_result_list.size());
+  for (int i = 0; i < ng_result_list.size(); i++) {
+    if (ng_result_list[i]->is_dynamic()) {
+      ng_output_shapes[i] = ov::Shape{};
+    } else {
+      ng_output_shapes[i] = ng_result_list[i]->get_shape();
     }
-    if (m_ng_exec_map.size() >= m_function_cache_depth_in_items) {
-      evicted_ng_exec = m_ng_exec_map[m_lru.back()];
-      m_ng_exec_map.erase(m_lru.back());
+  }
 
-      m_lru.pop_back();
-    }  // cache eviction if cache size greater than cache depth
+  try {
+    ng_exec = BackendManager::GetBackend()->Compile(ng_function, false,
+                                                    compile_properties);
+  } catch (const std::exception& ex) {
+    return errors::Internal("Failed to compile function " + m_name + ": ",
+                            ex.what());
+  }
 
+  ng_exec->SetOutputShapes(ng_output_shapes);
+  ng_exec->SetResultList(ng_result_list);
+  if (!model_cache_key.empty()) {
+    ModelCache::Store(model_cache_key, *ng_exec);
+  }
+  if (m_lean) {
     try {
-      ng_exec = backend->Compile(ng_function);
+      if (ng_exec->MakeLean()) {
+        ExecutionCounters::Increment(ExecutionCounters::kLeanExecutables);
+      } else {
+        OVTF_VLOG(1) << "Executable of " << m_name << " keeps its model";
+      }
     } catch (const std::exception& ex) {
       return errors::Internal("Failed to compile function " + m_name + ": ",
                               ex.what());
     }
+  }
+  if (m_profile) {
+    ClusterProfile::RecordCompile(m_profile_fingerprint,
+                                  compile_time.ElapsedInMicroSec());
+  }
+  return Status::OK();
+}
 
-    m_ng_exec_map[signature] = ng_exec;
-    ng_exec->SetOutputShapes(ng_output_shapes);
+// Returns a copy of the model translated for the static input values of
+// tf_input_tensors, with the non-static inputs reshaped to their current
+// shapes unless the model is compiled with dynamic shapes. The first miss of
+// a set of static input values translates the model with dynamic dims.
+// Returns null if the graph has to be translated for these input shapes.
+std::shared_ptr<ov::Model> NGraphEncapsulateOp::SpecializeModelTemplate(
+    const std::vector<Tensor>& tf_input_tensors,
+    const std::vector<TensorShape>& input_shapes,
+    const std::vector<const Tensor*>& static_input_map, bool dynamic) {
+  InputSignature template_signature;
+  if (!template_signature
+           .Compute(tf_input_tensors, m_input_is_static, m_input_is_dynamic)
+           .ok()) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(m_model_template_mutex);
+  if (m_model_templates_unsupported) return nullptr;
+  auto it = m_model_templates.find(template_signature);
+  bool reshaping = it != m_model_templates.end();
+  if (!reshaping) {
+    std::shared_ptr<ov::Model> ng_template;
+    ov::ResultVector ng_result_list;
+    std::shared_ptr<Graph> graph;
+    Status status = GetGraph(graph);
+    if (status.ok()) {
+      status = Builder::TranslateGraph(input_shapes, static_input_map,
+                                       graph.get(), m_name, ng_template,
+                                       ng_result_list, tf_input_tensors,
+                                       m_input_is_dynamic);
+    }
+    if (!status.ok()) {
+      OVTF_VLOG(1) << "Cluster " << m_name
+                   << " cannot be translated with dynamic shapes, every input "
+                      "shape is translated: "
+                   << status.error_message();
+      m_model_templates_unsupported = true;
+      return nullptr;
+    }
+    // Outputs that are dropped from the model are not found among the
+    // results of the reshaped copies
+    if (ng_template->get_results().size() != ng_result_list.size()) {
+      ng_template = nullptr;
+    }
+    while (!m_model_template_order.empty() &&
+           m_model_template_order.size() >= GetCacheDepth()) {
+      m_model_templates.erase(m_model_template_order.front());
+      m_model_template_order.pop_front();
+    }
+    m_model_template_order.push_back(template_signature);
+    it = m_model_templates.emplace(template_signature, ng_template).first;
+  } else {
+    OVTF_VLOG(1) << "Reshaping the translated model of " << m_name;
+  }
+  if (it->second == nullptr) return nullptr;
+
+  // Parameters of inputs with a zero dim are dropped from the model, so the
+  // remaining ones are matched to the inputs in order
+  size_t num_parameters = it->second->get_parameters().size();
+  std::vector<std::pair<size_t, ov::Shape>> ng_parameter_shapes;
+  size_t j = 0;
+  for (int i = 0; i < input_shapes.size(); i++) {
+    if (input_shapes[i].dims() > 0 && input_shapes[i].num_elements() == 0) {
+      if (m_input_is_dynamic[i]) return nullptr;
+      continue;
+    }
+    if (j >= num_parameters) return nullptr;
+    if (m_input_is_dynamic[i]) {
+      ov::Shape ng_shape;
+      if (!util::TFTensorShapeToNGraphShape(input_shapes[i], &ng_shape).ok()) {
+        return nullptr;
+      }
+      ng_parameter_shapes.emplace_back(j, ng_shape);
+    }
+    j++;
+  }
+  if (j != num_parameters) return nullptr;
 
-    m_lru.push_front(signature);
+  auto ng_function = it->second->clone();
+  if (dynamic) return ng_function;
 
-    // Memory after
-    util::MemoryProfile(vm, rss);
-    auto delta_vm_mem = vm - vm0;
-    auto delta_res_mem = rss - rss0;
-    OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
-                 << " Cache length: " << m_ng_exec_map.size()
-                 << " Cluster: " << m_name << " Delta VM: " << delta_vm_mem
-                 << " Delta RSS: " << delta_res_mem
-                 << " KB Total RSS: " << rss / (1024 * 1024) << " GB "
-                 << " VM: " << vm / (1024 * 1024) << " GB" << endl;
-  }  // end of input signature not found in m_ng_exec_map
-  else {
-    // Found the input signature in m_ng_exec_map, use the cached executable
-    // Update the m_lru
-    if (signature != m_lru.front()) {
-      m_lru.remove(signature);
-      m_lru.push_front(signature);
+  // The outputs of the reshaped model have to be as static as those of a
+  // translation for these shapes
+  std::map<ov::Output<ov::Node>, ov::PartialShape> ng_shapes;
+  for (const auto& parameter_shape : ng_parameter_shapes) {
+    ng_shapes[ng_function->get_parameters()[parameter_shape.first]->output(
+        0)] = parameter_shape.second;
+  }
+  try {
+    ng_function->reshape(ng_shapes);
+  } catch (const std::exception& ex) {
+    OVTF_VLOG(1) << "Failed to reshape the translated model of " << m_name
+                 << ": " << ex.what();
+    return nullptr;
+  }
+  for (const auto& ng_result : ng_function->get_results()) {
+    const auto& ng_shape = ng_result->get_output_partial_shape(0);
+    if (ng_shape.is_dynamic()) return nullptr;
+    for (auto dim : ng_shape.to_shape()) {
+      if (dim == 0) return nullptr;
     }
-    ng_exec = it->second;
   }
+  if (reshaping) {
+    ExecutionCounters::Increment(ExecutionCounters::kTemplateReshapes);
+  }
+  return ng_function;
+}
+
+// Returns true if the batch analysis proved that the translations for the
+// static input values of tf_input_tensors compute the rows of a batch
+// independently
+bool NGraphEncapsulateOp::RowsAreIndependent(
+    const std::vector<Tensor>& tf_input_tensors) {
+  InputSignature key;
+  if (!key.Compute(tf_input_tensors, m_input_is_static, m_input_is_dynamic)
+           .ok()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_row_independence_mutex);
+  auto it = m_row_independence.find(key);
+  return it != m_row_independence.end() && it->second;
+}
+
+// Runs the batch analysis for the static input values of tf_input_tensors
+// unless it is known already. ng_function is the translation for them. The
+// graph is translated with static shapes for the analysis if it is null,
+// e.g. for a model loaded from the model cache, or dynamic.
+void NGraphEncapsulateOp::AnalyzeRows(
+    const std::vector<Tensor>& tf_input_tensors,
+    std::shared_ptr<ov::Model> ng_function) {
+  if (!m_batch_bucketing && m_micro_batcher == nullptr) return;
+  InputSignature key;
+  if (!key.Compute(tf_input_tensors, m_input_is_static, m_input_is_dynamic)
+           .ok()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_row_independence_mutex);
+    if (m_row_independence.count(key) != 0) return;
+  }
+
+  bool independent = false;
+  std::string reason;
+  Status status;
+  if (ng_function == nullptr || ng_function->is_dynamic()) {
+    std::vector<const Tensor*> static_input_map(tf_input_tensors.size());
+    std::vector<TensorShape> input_shapes;
+    for (int i = 0; i < tf_input_tensors.size(); i++) {
+      input_shapes.push_back(tf_input_tensors[i].shape());
+      if (m_input_is_static[i]) static_input_map[i] = &tf_input_tensors[i];
+    }
+    ov::ResultVector ng_result_list;
+    std::shared_ptr<Graph> graph;
+    status = GetGraph(graph);
+    if (status.ok()) {
+      status = Builder::TranslateGraph(input_shapes, static_input_map,
+                                       graph.get(), m_name, ng_function,
+                                       ng_result_list, tf_input_tensors,
+                                       kNoDynamicInputs);
+    }
+    if (m_lean) ReleaseGraph();
+    if (!status.ok()) reason = status.error_message();
+  }
+  if (status.ok()) {
+    independent = BatchAnalysis::RowsAreIndependent(ng_function, reason);
+  }
+  if (independent) {
+    OVTF_VLOG(1) << "Rows of the batch of " << m_name << " are independent";
+  } else {
+    OVTF_VLOG(1) << "Batches of " << m_name
+                 << " are not padded or coalesced: " << reason;
+  }
+
+  // Clusters with static inputs may see many of their values
+  std::lock_guard<std::mutex> lock(m_row_independence_mutex);
+  if (m_row_independence.size() >= 64) {
+    m_row_independence.erase(m_row_independence.begin());
+  }
+  m_row_independence[key] = independent;
+}
+
+// Maximum number of executables cached for this cluster
+size_t NGraphEncapsulateOp::GetCacheDepth() {
+  const char* cache_depth_specified =
+      std::getenv("OPENVINO_TF_FUNCTION_CACHE_ITEM_DEPTH");
+  if (cache_depth_specified != nullptr) {
+    m_function_cache_depth_in_items =
+        (int)strtol(cache_depth_specified, NULL, 10);
+  }
+  return std::max(m_function_cache_depth_in_items, 1);
+}
+
+// Adds a new executable to the process-wide executable cache. It is charged
+// with its own size, see Executable::GetSizeBytes, which unlike the memory
+// growth of the process does not include the compilations that ran at the
+// same time. Requires m_exec_cache_mutex.
+void NGraphEncapsulateOp::InsertExecutable(
+    const InputSignature& signature, std::shared_ptr<Executable> ng_exec) {
+  int64 size_bytes = ng_exec->GetSizeBytes();
+  ExecutableCache::Insert(this, signature, ng_exec, size_bytes,
+                          GetCacheDepth());
+
+  long vm = 0, rss = 0;
+  util::MemoryProfile(vm, rss);
+  OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: OP_ID: " << m_cluster_id
+               << " Cache length: " << ExecutableCache::NumEntries(this)
+               << " Cluster: " << m_name
+               << " Total RSS: " << rss / (1024 * 1024) << " GB "
+               << " VM: " << vm / (1024 * 1024) << " GB"
+               << " Executable: " << size_bytes / 1024 << " KB"
+               << (ng_exec->IsLean() ? " (lean)" : "") << endl;
+  if (ConstantPool::IsEnabled()) {
+    auto pool_stats = ConstantPool::GetStats();
+    OVTF_VLOG(1) << "OPENVINO_TF_CACHE_PROFILE: Constant pool buffers: "
+                 << pool_stats.num_buffers
+                 << " Size: " << pool_stats.size_bytes / 1024
+                 << " KB Shared: " << pool_stats.shared_bytes / 1024 << " KB";
+  }
+}
+
+// Returns the cluster graph, rebuilding it if it was released
+Status NGraphEncapsulateOp::GetGraph(std::shared_ptr<Graph>& graph) {
+  std::lock_guard<std::mutex> lock(m_graph_mutex);
+  if (m_graph == nullptr) {
+    const GraphDef* graph_def =
+        m_graph_def.node_size() > 0
+            ? &m_graph_def
+            : NGraphClusterManager::GetClusterGraph(m_cluster_id);
+    if (graph_def == nullptr) {
+      return errors::Internal("No graph left for cluster ", m_cluster_id);
+    }
+    auto new_graph = std::make_shared<Graph>(OpRegistry::Global());
+    GraphConstructorOptions opts;
+    opts.allow_internal_ops = true;
+    TF_RETURN_IF_ERROR(
+        ConvertGraphDefToGraph(opts, *graph_def, new_graph.get()));
+    m_graph = new_graph;
+  }
+  graph = m_graph;
   return Status::OK();
 }
 
+// Drops the cluster graph until the next translation. Translations still
+// using it keep it alive.
+void NGraphEncapsulateOp::ReleaseGraph() {
+  std::lock_guard<std::mutex> lock(m_graph_mutex);
+  m_graph.reset();
+}
+
 Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
   OVTF_VLOG(1) << "Cluster " << name() << " fallback to native TF runtime ";
-  if (!NGraphClusterManager::CheckClusterFallback(m_cluster_id)) {
-    NGraphClusterManager::SetClusterFallback(m_cluster_id, true);
+  NGraphClusterManager::SetClusterFallback(m_cluster_id, true);
+  return RunFallbackSession(ctx);
+}
+
+// Runs the cluster on a native TF session. Unlike Fallback, this does not
+// mark the cluster as fallen back.
+Status NGraphEncapsulateOp::RunFallbackSession(OpKernelContext* ctx) {
+  std::unique_lock<std::mutex> fallback_lock(m_fallback_mutex);
+  if (m_session == nullptr) {
     GraphDef* graph_def = NGraphClusterManager::GetClusterGraph(m_cluster_id);
     SessionOptions options;
     std::shared_ptr<tensorflow::Session> session(
@@ -636,10 +1758,15 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
     if (!session_create_status.ok()) {
       return session_create_status;
     }
-    m_session = session;
 
+    // The session is published with its input and output names only once
+    // all of them are known, an error leaves it unset for the next call
+    std::shared_ptr<Graph> graph;
+    TF_RETURN_IF_ERROR(GetGraph(graph));
+    // A lean kernel drops the rebuilt graph once the names are collected
+    if (m_lean) ReleaseGraph();
     vector<Node*> ordered;
-    GetReversePostOrder(m_graph, &ordered, NodeComparatorName());
+    GetReversePostOrder(*graph, &ordered, NodeComparatorName());
 
     vector<const Node*> tf_params;
     vector<const Node*> tf_ret_vals;
@@ -661,7 +1788,7 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
         tf_ret_vals.push_back(n);
       }
     }
-    m_session_input_names.resize(tf_params.size());
+    std::vector<std::string> input_names(tf_params.size());
     for (auto parm : tf_params) {
       DataType dtype;
       if (GetNodeAttr(parm->attrs(), "T", &dtype) != Status::OK()) {
@@ -671,9 +1798,9 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
       if (GetNodeAttr(parm->attrs(), "index", &index) != Status::OK()) {
         return errors::InvalidArgument("No index defined for _Arg");
       }
-      m_session_input_names[index] = parm->name();
+      input_names[index] = parm->name();
     }
-    m_session_output_names.resize(tf_ret_vals.size());
+    std::vector<std::string> output_names(tf_ret_vals.size());
     for (auto n : tf_ret_vals) {
       if (n->num_inputs() != 1) {
         return errors::InvalidArgument("_Retval has ", n->num_inputs(),
@@ -685,11 +1812,14 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
       }
       std::vector<const Edge*> output_edges;
       TF_RETURN_IF_ERROR(n->input_edges(&output_edges));
-      m_session_output_names[index] =
-          output_edges[0]->src()->name() + ":" +
-          std::to_string(output_edges[0]->src_output());
+      output_names[index] = output_edges[0]->src()->name() + ":" +
+                            std::to_string(output_edges[0]->src_output());
     }
+    m_session_input_names = std::move(input_names);
+    m_session_output_names = std::move(output_names);
+    m_session = session;
   }
+  fallback_lock.unlock();
 
   std::vector<std::pair<string, Tensor>> input_tensor_list(
       m_session_input_names.size());
@@ -700,12 +1830,18 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
   tensorflow::RunOptions run_options;
   run_options.set_inter_op_thread_pool(-1);
   tensorflow::RunMetadata run_metadata;
+  Timer tf_time;
   Status run_status =
       m_session->Run(run_options, input_tensor_list, m_session_output_names, {},
                      &outputs, &run_metadata);
   if (run_status != Status::OK()) {
     return errors::Internal("Failed to run TF session for " + name());
   }
+  // The first run of the session includes its setup
+  if (m_session_warm.exchange(true) && m_profile) {
+    ClusterProfile::RecordTF(m_profile_fingerprint,
+                             tf_time.ElapsedInMicroSec());
+  }
   for (int i = 0; i < outputs.size(); i++) {
     Tensor* output_tensor = ctx->mutable_output(i);
     if (output_tensor == nullptr) {
@@ -724,6 +1860,16 @@ Status NGraphEncapsulateOp::Fallback(OpKernelContext* ctx) {
   return Status::OK();
 }
 
+// With the cluster profile enabled, a call out of kTFSampleInterval runs on
+// native TF until the profile holds enough TF measurements of the cluster to
+// compare it with OpenVINO
+bool NGraphEncapsulateOp::SampleTF() {
+  if (++m_profile_calls % ClusterProfile::kTFSampleInterval != 0) return false;
+  ClusterProfile::Entry entry;
+  ClusterProfile::Lookup(m_profile_fingerprint, entry);
+  return entry.tf_calls < ClusterProfile::kMinTFCalls;
+}
+
 }  // namespace openvino_tensorflow
 
 REGISTER_KERNEL_BUILDER(Name("_nGraphEncapsulate").Device(DEVICE_CPU),
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <utility>
+
+#include "openvino_tensorflow/micro_batcher.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+MicroBatcher::MicroBatcher(std::chrono::microseconds window, int64_t max_rows,
+                           RunFn run)
+    : m_window(window), m_max_rows(max_rows), m_run(std::move(run)) {
+  m_timer = std::thread([this]() { TimerLoop(); });
+}
+
+MicroBatcher::~MicroBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_batch_opened.notify_all();
+  m_timer.join();
+}
+
+void MicroBatcher::CloseLocked(const std::string& key,
+                               std::vector<ClosedBatch>& closed) {
+  auto it = m_open_batches.find(key);
+  if (it == m_open_batches.end()) return;
+  closed.emplace_back(key, std::move(it->second->requests));
+  m_open_batches.erase(it);
+}
+
+void MicroBatcher::RunClosed(std::vector<ClosedBatch>& closed) {
+  for (auto& batch : closed) m_run(batch.first, std::move(batch.second));
+  closed.clear();
+}
+
+void MicroBatcher::Add(const std::string& key, Request request) {
+  std::vector<ClosedBatch> closed;
+  bool opened = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool joined = false;
+    auto it = m_open_batches.find(key);
+    if (it != m_open_batches.end()) {
+      auto& batch = *it->second;
+      if (batch.rows + request.rows <= m_max_rows) {
+        batch.rows += request.rows;
+        batch.requests.push_back(std::move(request));
+        joined = true;
+        if (batch.rows >= m_max_rows) CloseLocked(key, closed);
+      } else {
+        // Run the open batch right away, the request starts the next one
+        CloseLocked(key, closed);
+      }
+    }
+    if (!joined && request.rows >= m_max_rows) {
+      closed.emplace_back(key, std::vector<Request>{std::move(request)});
+    } else if (!joined) {
+      auto batch = std::make_shared<Batch>();
+      batch->rows = request.rows;
+      batch->deadline = std::chrono::steady_clock::now() + m_window;
+      batch->requests.push_back(std::move(request));
+      m_open_batches[key] = batch;
+      opened = true;
+    }
+  }
+  if (opened) m_batch_opened.notify_one();
+  RunClosed(closed);
+}
+
+void MicroBatcher::TimerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    std::vector<ClosedBatch> closed;
+    auto now = std::chrono::steady_clock::now();
+    auto next_deadline = std::chrono::steady_clock::time_point::max();
+    for (auto it = m_open_batches.begin(); it != m_open_batches.end();) {
+      if (m_stopping || it->second->deadline <= now) {
+        closed.emplace_back(it->first, std::move(it->second->requests));
+        it = m_open_batches.erase(it);
+      } else {
+        next_deadline = std::min(next_deadline, it->second->deadline);
+        ++it;
+      }
+    }
+    if (!closed.empty()) {
+      lock.unlock();
+      RunClosed(closed);
+      lock.lock();
+      continue;
+    }
+    if (m_stopping) return;
+    if (m_open_batches.empty()) {
+      m_batch_opened.wait(lock);
+    } else {
+      m_batch_opened.wait_until(lock, next_deadline);
+    }
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
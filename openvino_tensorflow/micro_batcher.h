@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_MICRO_BATCHER_H_
+#define OPENVINO_TF_MICRO_BATCHER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tensorflow {
+
+class OpKernelContext;
+
+namespace openvino_tensorflow {
+
+// Groups concurrent calls of a cluster whose inputs only differ in their
+// batch size, so that they run as one batched inference.
+//
+// A batch stays open for more calls with the same key for up to the window
+// after its first call, or until it holds max_rows rows. Calls return right
+// away and complete when their batch does. Batches that fill up are run by
+// the call that filled them, the others by a timer thread of the batcher
+// once their window has expired, so run must not block.
+class MicroBatcher {
+ public:
+  struct Request {
+    OpKernelContext* ctx;
+    std::function<void()> done;
+    // Batch size of the inputs of the call
+    int64_t rows;
+  };
+  using RunFn =
+      std::function<void(const std::string& key, std::vector<Request>)>;
+
+  MicroBatcher(std::chrono::microseconds window, int64_t max_rows,
+               RunFn run);
+  // Runs the batches that are still open
+  ~MicroBatcher();
+
+  // Adds the request to the open batch of its key. A request that does not
+  // fit in it closes it and starts a new one.
+  void Add(const std::string& key, Request request);
+
+  int64_t GetMaxRows() const { return m_max_rows; }
+
+ private:
+  struct Batch {
+    std::vector<Request> requests;
+    int64_t rows = 0;
+    std::chrono::steady_clock::time_point deadline;
+  };
+  using ClosedBatch = std::pair<std::string, std::vector<Request>>;
+
+  // Requires m_mutex
+  void CloseLocked(const std::string& key, std::vector<ClosedBatch>& closed);
+  void RunClosed(std::vector<ClosedBatch>& closed);
+  void TimerLoop();
+
+  const std::chrono::microseconds m_window;
+  const int64_t m_max_rows;
+  const RunFn m_run;
+  std::mutex m_mutex;
+  std::condition_variable m_batch_opened;
+  bool m_stopping = false;
+  // The batches still accepting requests, by key
+  std::unordered_map<std::string, std::shared_ptr<Batch>> m_open_batches;
+  std::thread m_timer;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_MICRO_BATCHER_H_
@@ -0,0 +1,380 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/hash/hash.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/default_opset.h"
+#include "openvino_tensorflow/model_cache.h"
+#include "openvino_tensorflow/version.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+namespace {
+
+constexpr char kCacheFileMagic[] = "OVTF_MODEL_CACHE 1";
+constexpr char kCacheFileSuffix[] = ".ovtfcache";
+constexpr int64 kDefaultSizeLimitMB = 4096;
+
+void WriteType(std::ostream& os, const ov::element::Type& type) {
+  os << static_cast<int>(ov::element::Type_t(type));
+}
+
+bool ReadType(std::istream& is, ov::element::Type& type) {
+  int type_id;
+  if (!(is >> type_id)) return false;
+  type = ov::element::Type(static_cast<ov::element::Type_t>(type_id));
+  return true;
+}
+
+void WriteShape(std::ostream& os, const ov::Shape& shape) {
+  os << shape.size();
+  for (auto dim : shape) os << " " << dim;
+}
+
+bool ReadShape(std::istream& is, ov::Shape& shape) {
+  size_t rank;
+  if (!(is >> rank)) return false;
+  shape.resize(rank);
+  for (auto& dim : shape) {
+    if (!(is >> dim)) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::string ModelCache::s_cache_dir;
+bool ModelCache::s_cache_dir_initialized = false;
+std::mutex ModelCache::s_cache_dir_mutex;
+std::atomic<int64> ModelCache::s_hits{0};
+std::atomic<int64> ModelCache::s_misses{0};
+std::atomic<int64> ModelCache::s_stores{0};
+
+std::string ModelCache::EntryPath(const std::string& cache_dir,
+                                  const std::string& key) {
+  return io::JoinPath(cache_dir, key + kCacheFileSuffix);
+}
+
+bool ModelCache::IsEnabled() { return !GetCacheDir().empty(); }
+
+void ModelCache::SetCacheDir(const std::string& cache_dir) {
+  std::lock_guard<std::mutex> lock(s_cache_dir_mutex);
+  s_cache_dir = cache_dir;
+  s_cache_dir_initialized = true;
+}
+
+std::string ModelCache::GetCacheDir() {
+  std::lock_guard<std::mutex> lock(s_cache_dir_mutex);
+  if (!s_cache_dir_initialized) {
+    const char* cache_dir = std::getenv("OPENVINO_TF_MODEL_CACHE_DIR");
+    if (cache_dir != nullptr) {
+      s_cache_dir = cache_dir;
+    }
+    s_cache_dir_initialized = true;
+  }
+  return s_cache_dir;
+}
+
+uint64 ModelCache::GraphFingerprint(const Graph& graph) {
+  GraphDef graph_def;
+  graph.ToGraphDef(&graph_def);
+  string serialized;
+  SerializeToStringDeterministic(graph_def, &serialized);
+  return Hash64(serialized.data(), serialized.size());
+}
+
+std::string ModelCache::MakeKey(uint64 graph_fingerprint,
+                                const InputSignature& signature,
+                                const std::string& device_type) {
+  std::string material(reinterpret_cast<const char*>(&graph_fingerprint),
+                       sizeof(graph_fingerprint));
+  material += signature.Bytes();
+  material += '\0';
+  material += device_type;
+  material += '\0';
+  material += version();
+  material += '\0';
+  material += openvino_version();
+  material += '\0';
+  material += ov::get_openvino_version().buildNumber;
+
+  // Two hashes with different seeds make a 128-bit key
+  std::ostringstream oss;
+  oss << std::hex << std::setfill('0') << std::setw(16)
+      << Hash64(material.data(), material.size(), 0x9ae16a3b2f90404fULL)
+      << std::setw(16)
+      << Hash64(material.data(), material.size(), 0xc3a5c85c97cb3127ULL);
+  return oss.str();
+}
+
+std::shared_ptr<Executable> ModelCache::Load(const std::string& key) {
+  auto cache_dir = GetCacheDir();
+  if (cache_dir.empty()) return nullptr;
+
+  auto path = EntryPath(cache_dir, key);
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    s_misses++;
+    OVTF_VLOG(1) << "OPENVINO_TF_MODEL_CACHE: miss " << key
+                 << " Hits: " << s_hits << " Misses: " << s_misses;
+    return nullptr;
+  }
+
+  try {
+    std::string magic;
+    std::getline(file, magic);
+    if (magic != kCacheFileMagic) {
+      throw runtime_error("unknown file format");
+    }
+    size_t meta_size = 0;
+    file >> meta_size;
+    file.ignore(1);
+    std::string meta(meta_size, '\0');
+    if (!file.read(&meta[0], meta_size)) {
+      throw runtime_error("truncated file");
+    }
+
+    // Rebuild the description of the model inputs and outputs
+    std::istringstream meta_is(meta);
+    ov::ParameterVector params;
+    ov::ResultVector results;
+    ov::ResultVector ng_result_list;
+    std::vector<ov::Shape> ng_output_shapes;
+    std::vector<int> skipped_inputs;
+    std::string token;
+    bool complete = false;
+    while (meta_is >> token) {
+      ov::element::Type type;
+      ov::Shape shape;
+      std::string name;
+      if (token == "key") {
+        std::string stored_key;
+        meta_is >> stored_key;
+        if (stored_key != key) throw runtime_error("key mismatch");
+      } else if (token == "skipped") {
+        size_t count = 0;
+        meta_is >> count;
+        skipped_inputs.resize(count);
+        for (auto& index : skipped_inputs) meta_is >> index;
+      } else if (token == "param") {
+        if (!(meta_is >> std::quoted(name)) || !ReadType(meta_is, type) ||
+            !ReadShape(meta_is, shape)) {
+          throw runtime_error("malformed parameter");
+        }
+        auto param = std::make_shared<opset::Parameter>(type, shape);
+        param->set_friendly_name(name);
+        params.push_back(param);
+      } else if (token == "result") {
+        if (!(meta_is >> std::quoted(name)) || !ReadType(meta_is, type) ||
+            !ReadShape(meta_is, shape)) {
+          throw runtime_error("malformed result");
+        }
+        auto result =
+            std::make_shared<opset::Result>(MakeStubOutput(type, shape));
+        result->set_friendly_name(name);
+        results.push_back(result);
+      } else if (token == "output") {
+        if (!ReadType(meta_is, type) || !ReadShape(meta_is, shape)) {
+          throw runtime_error("malformed output");
+        }
+        ng_result_list.push_back(
+            std::make_shared<opset::Result>(MakeStubOutput(type, shape)));
+        ng_output_shapes.push_back(shape);
+      } else if (token == "end") {
+        complete = true;
+        break;
+      } else {
+        throw runtime_error("unexpected entry " + token);
+      }
+    }
+    if (!complete) throw runtime_error("incomplete metadata");
+
+    // The rest of the file is the compiled model, its size stands in for
+    // the memory of the executable
+    auto model_start = file.tellg();
+    file.seekg(0, std::ios::end);
+    int64 model_bytes = file.tellg() - model_start;
+    file.seekg(model_start);
+
+    auto io_model = std::make_shared<ov::Model>(results, params, key);
+    auto backend = BackendManager::GetBackend();
+    auto ng_exec = backend->Import(file, io_model, skipped_inputs);
+    if (ng_exec == nullptr) {
+      throw runtime_error("backend does not support imported models");
+    }
+    ng_exec->SetSizeBytes(model_bytes);
+    ng_exec->SetOutputShapes(ng_output_shapes);
+    ng_exec->SetResultList(ng_result_list);
+
+    s_hits++;
+    OVTF_VLOG(1) << "OPENVINO_TF_MODEL_CACHE: hit " << key
+                 << " Hits: " << s_hits << " Misses: " << s_misses;
+    return ng_exec;
+  } catch (const std::exception& e) {
+    // Drop the entry, it is rewritten once the model has been compiled again
+    OVTF_VLOG(0) << "Discarding model cache entry " << path << ": "
+                 << e.what();
+    file.close();
+    Env::Default()->DeleteFile(path).IgnoreError();
+    s_misses++;
+    return nullptr;
+  }
+}
+
+void ModelCache::Store(const std::string& key, Executable& executable) {
+  auto cache_dir = GetCacheDir();
+  if (cache_dir.empty()) return;
+  if (!executable.IsCacheable()) {
+    OVTF_VLOG(1) << "OPENVINO_TF_MODEL_CACHE: executable " << key
+                 << " cannot be cached";
+    return;
+  }
+
+  try {
+    std::ostringstream meta;
+    meta << "key " << key << "\n";
+    const auto& skipped_inputs = executable.GetSkippedInputs();
+    meta << "skipped " << skipped_inputs.size();
+    for (auto index : skipped_inputs) meta << " " << index;
+    meta << "\n";
+    auto model = executable.GetModel();
+    for (const auto& param : model->get_parameters()) {
+      meta << "param " << std::quoted(param->get_friendly_name()) << " ";
+      WriteType(meta, param->get_element_type());
+      meta << " ";
+      WriteShape(meta, param->get_shape());
+      meta << "\n";
+    }
+    for (const auto& result : model->get_results()) {
+      meta << "result " << std::quoted(result->get_friendly_name()) << " ";
+      WriteType(meta, result->get_element_type());
+      meta << " ";
+      WriteShape(meta, result->get_shape());
+      meta << "\n";
+    }
+    const auto& ng_result_list = executable.GetResultList();
+    const auto ng_output_shapes = executable.GetOutputShapes();
+    for (int i = 0; i < ng_result_list.size(); i++) {
+      meta << "output ";
+      WriteType(meta, ng_result_list[i]->get_element_type());
+      meta << " ";
+      WriteShape(meta, ng_output_shapes[i]);
+      meta << "\n";
+    }
+    meta << "end\n";
+
+    std::ostringstream contents;
+    auto meta_str = meta.str();
+    contents << kCacheFileMagic << "\n" << meta_str.size() << "\n" << meta_str;
+    executable.GetCompiledModel().export_model(contents);
+
+    Status status = WriteEntry(cache_dir, key, contents.str());
+    if (!status.ok()) {
+      OVTF_VLOG(0) << status.error_message();
+      return;
+    }
+    s_stores++;
+    OVTF_VLOG(1) << "OPENVINO_TF_MODEL_CACHE: stored " << key
+                 << " Stores: " << s_stores;
+    EnforceSizeLimit(cache_dir, SizeLimitBytes());
+  } catch (const std::exception& e) {
+    OVTF_VLOG(0) << "Cannot export compiled model " << key << ": "
+                 << e.what();
+  }
+}
+
+Status ModelCache::WriteEntry(const std::string& cache_dir,
+                              const std::string& key,
+                              const std::string& contents) {
+  Env* env = Env::Default();
+  Status status = env->RecursivelyCreateDir(cache_dir);
+  if (!status.ok()) {
+    return errors::Internal("Cannot create model cache directory ", cache_dir,
+                            ": ", status.error_message());
+  }
+  auto path = EntryPath(cache_dir, key);
+  // The temporary file is unique to the writer, concurrent stores of the
+  // same key each rename a complete entry
+  auto tmp_path = path + ".tmp." + to_string(env->NowMicros()) + "." +
+                  to_string(env->GetCurrentThreadId());
+  status = WriteStringToFile(env, tmp_path, contents);
+  if (status.ok()) {
+    status = env->RenameFile(tmp_path, path);
+  }
+  if (!status.ok()) {
+    env->DeleteFile(tmp_path).IgnoreError();
+    return errors::Internal("Cannot write model cache entry ", path, ": ",
+                            status.error_message());
+  }
+  return Status::OK();
+}
+
+int64 ModelCache::SizeLimitBytes() {
+  int64 limit_mb = kDefaultSizeLimitMB;
+  const char* limit_env = std::getenv("OPENVINO_TF_MODEL_CACHE_SIZE_LIMIT");
+  if (limit_env != nullptr) {
+    limit_mb = strtoll(limit_env, nullptr, 10);
+  }
+  return limit_mb * 1024 * 1024;
+}
+
+void ModelCache::EnforceSizeLimit(const std::string& cache_dir,
+                                  int64 limit_bytes) {
+  if (limit_bytes <= 0) return;
+
+  Env* env = Env::Default();
+  std::vector<string> children;
+  if (!env->GetChildren(cache_dir, &children).ok()) return;
+
+  struct Entry {
+    string path;
+    int64 size;
+    int64 mtime;
+  };
+  std::vector<Entry> entries;
+  int64 total = 0;
+  const string suffix(kCacheFileSuffix);
+  for (const auto& child : children) {
+    if (child.size() <= suffix.size() ||
+        child.compare(child.size() - suffix.size(), suffix.size(), suffix) !=
+            0) {
+      continue;
+    }
+    auto path = io::JoinPath(cache_dir, child);
+    FileStatistics stat;
+    if (!env->Stat(path, &stat).ok()) continue;
+    entries.push_back({path, stat.length, stat.mtime_nanos});
+    total += stat.length;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.mtime < b.mtime; });
+  // Keep at least the newest entry
+  for (size_t i = 0; total > limit_bytes && i + 1 < entries.size(); i++) {
+    if (env->DeleteFile(entries[i].path).ok()) {
+      total -= entries[i].size;
+      OVTF_VLOG(1) << "OPENVINO_TF_MODEL_CACHE: evicted " << entries[i].path;
+    }
+  }
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_MODEL_CACHE_H_
+#define OPENVINO_TF_MODEL_CACHE_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "tensorflow/core/graph/graph.h"
+
+#include "openvino_tensorflow/executable.h"
+#include "openvino_tensorflow/input_signature.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// On-disk cache of compiled models. Each entry holds the exported compiled
+// model together with the description of its inputs and outputs, so a later
+// process can import it and skip both the graph translation and the
+// compilation. Entries are keyed by the cluster graph, the input signature,
+// the device type and the versions of OpenVINO and openvino_tensorflow.
+//
+// The cache is enabled by setting a directory through
+// OPENVINO_TF_MODEL_CACHE_DIR or api::SetModelCacheDir. Its size is bounded
+// by OPENVINO_TF_MODEL_CACHE_SIZE_LIMIT (in MB), the oldest entries are
+// removed first.
+class ModelCache {
+ public:
+  static bool IsEnabled();
+  static void SetCacheDir(const std::string& cache_dir);
+  static std::string GetCacheDir();
+
+  // Fingerprint of a cluster graph, computed once per cluster
+  static uint64 GraphFingerprint(const Graph& graph);
+  static std::string MakeKey(uint64 graph_fingerprint,
+                             const InputSignature& signature,
+                             const std::string& device_type);
+
+  // Returns the cached executable, or nullptr on a miss
+  static std::shared_ptr<Executable> Load(const std::string& key);
+  // Exports the compiled model of the executable. Failures are logged and
+  // otherwise ignored, the executable stays usable.
+  static void Store(const std::string& key, Executable& executable);
+
+  static int64 NumHits() { return s_hits; }
+  static int64 NumMisses() { return s_misses; }
+  static int64 NumStores() { return s_stores; }
+
+  // Path of the entry of the key in the cache directory
+  static std::string EntryPath(const std::string& cache_dir,
+                               const std::string& key);
+  // Writes the contents of an entry to a temporary file that is then renamed
+  // to the entry, so readers never see a partial entry
+  static Status WriteEntry(const std::string& cache_dir, const std::string& key,
+                           const std::string& contents);
+  // Removes the oldest entries until the cache directory holds at most
+  // limit_bytes, the newest entry is always kept. A limit <= 0 disables it.
+  static void EnforceSizeLimit(const std::string& cache_dir, int64 limit_bytes);
+
+ private:
+  // OPENVINO_TF_MODEL_CACHE_SIZE_LIMIT in bytes
+  static int64 SizeLimitBytes();
+
+  static std::string s_cache_dir;
+  static bool s_cache_dir_initialized;
+  static std::mutex s_cache_dir_mutex;
+  static std::atomic<int64> s_hits;
+  static std::atomic<int64> s_misses;
+  static std::atomic<int64> s_stores;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_MODEL_CACHE_H_
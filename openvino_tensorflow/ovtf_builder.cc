@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: Apache-2.0
  *******************************************************************************/
 
+#include <numeric>
+
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
@@ -16,6 +18,7 @@
 #include "api.h"
 #include "logging/ovtf_log.h"
 #include "openvino_tensorflow/backend_manager.h"
+#include "openvino_tensorflow/constant_pool.h"
 #include "openvino_tensorflow/default_opset.h"
 #include "openvino_tensorflow/layout_conversions.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
@@ -461,6 +464,30 @@ static Status ValuesFromConstNode(const NodeDef& node,
   return Status::OK();
 }
 
+// Builds a Constant whose data is shared with identical constants of other
+// translated models through the ConstantPool
+template <typename T>
+static ov::Output<ov::Node> MakePooledConstant(const std::string& op_name,
+                                               ov::element::Type et,
+                                               ov::Shape ng_shape,
+                                               const vector<T>& values) {
+  auto ng_node = ConstantPool::MakeConstant(et, ng_shape, values.data(),
+                                            values.size() * sizeof(T));
+  if (ng_node == nullptr) {
+    return ConstructNgNode<opset::Constant>(op_name, et, ng_shape, values);
+  }
+  Builder::SetTracingInfo(op_name, ng_node);
+  return ng_node;
+}
+
+// std::vector<bool> does not store its values contiguously
+static ov::Output<ov::Node> MakePooledConstant(const std::string& op_name,
+                                               ov::element::Type et,
+                                               ov::Shape ng_shape,
+                                               const vector<bool>& values) {
+  return ConstructNgNode<opset::Constant>(op_name, et, ng_shape, values);
+}
+
 template <typename T>
 static Status MakeConstOpForParam(const Tensor& tensor, string prov_tag,
                                   ov::element::Type ng_et, ov::Shape ng_shape,
@@ -468,8 +495,7 @@ static Status MakeConstOpForParam(const Tensor& tensor, string prov_tag,
   vector<T> const_values;
 
   TensorDataToVector(tensor, &const_values);
-  ng_node =
-      ConstructNgNode<opset::Constant>(prov_tag, ng_et, ng_shape, const_values);
+  ng_node = MakePooledConstant(prov_tag, ng_et, ng_shape, const_values);
 
   return Status::OK();
 }
@@ -489,8 +515,7 @@ static Status MakeConstOp(const Node* op, ov::element::Type et,
   ov::Shape ng_shape;
   TF_RETURN_IF_ERROR(util::TFTensorShapeToNGraphShape(const_shape, &ng_shape));
 
-  ng_node =
-      ConstructNgNode<opset::Constant>(op->name(), et, ng_shape, const_values);
+  ng_node = MakePooledConstant(op->name(), et, ng_shape, const_values);
   return Status::OK();
 }
 
@@ -1349,9 +1374,14 @@ static Status TranslateCropAndResizeOp(
   /// ranges from 0 to batch
   /// ng_crop_size: [crop_height, crop_width];
 
-  /// for each box b specified in ng_boxes:
-  ///  1. crop ng_input[ng_box_ind[b]] w/ co-ordinates in ng_boxes
-  ///  2. resize according to method
+  /// The boxes and box indices are runtime inputs. Output pixel (b, y, x)
+  /// samples ng_input[ng_box_ind[b]] at
+  ///   in_y = y1 * (image_height - 1) +
+  ///          y * (y2 - y1) * (image_height - 1) / (crop_height - 1)
+  /// (at the center of the box if crop_height is 1), and likewise at in_x.
+  /// Samples outside of the image get the extrapolation value. The pixels
+  /// are gathered from the image flattened to [batch * height * width,
+  /// depth], so the subgraph does not depend on the number of boxes.
 
   ov::Output<ov::Node> ng_input, ng_boxes, ng_box_ind, ng_size;
   TF_RETURN_IF_ERROR(
@@ -1363,106 +1393,189 @@ static Status TranslateCropAndResizeOp(
   TF_RETURN_IF_ERROR(
       GetNodeAttr(op->attrs(), "extrapolation_value", &tf_extrapolation_value));
 
-  auto spatial_shape = ng_input.get_shape();
-  auto image_height = spatial_shape[1];
-  auto image_width = spatial_shape[2];
-  auto image_depth = spatial_shape[3];
-
-  std::vector<float> boxes;
-  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 1, static_input_map, &boxes));
-
-  std::vector<int64> box_ind;
-  TF_RETURN_IF_ERROR(GetStaticInputVector(op, 2, static_input_map, &box_ind));
+  auto spatial_shape = ng_input.get_partial_shape();
+  if (spatial_shape.rank().is_dynamic() ||
+      spatial_shape.rank().get_length() != 4 || spatial_shape[1].is_dynamic() ||
+      spatial_shape[2].is_dynamic() || spatial_shape[3].is_dynamic()) {
+    return errors::InvalidArgument(
+        "CropAndResize requires the image height, width and depth to be "
+        "static");
+  }
+  int64 image_height = spatial_shape[1].get_length();
+  int64 image_width = spatial_shape[2].get_length();
+  int64 image_depth = spatial_shape[3].get_length();
 
   std::vector<int64> crop_size;
   TF_RETURN_IF_ERROR(GetStaticInputVector(op, 3, static_input_map, &crop_size));
+  if (crop_size.size() != 2 || crop_size[0] <= 0 || crop_size[1] <= 0) {
+    return errors::InvalidArgument(
+        "CropAndResize crop_size must hold two positive values");
+  }
+  int64 crop_height = crop_size[0];
+  int64 crop_width = crop_size[1];
 
-  ov::OutputVector ng_crop_outputs(box_ind.size());
-  if (box_ind.size() == 0) {
-    SaveNgOp(
-        ng_op_map, op->name(),
-        ConstructNgNode<opset::Constant>(
-            op->name(), ov::element::f32,
-            ov::Shape{0, static_cast<unsigned long>(crop_size.at(0)),
-                      static_cast<unsigned long>(crop_size.at(1)), image_depth},
-            std::vector<float>({})));
-  } else {
-    for (int i = 0; i < box_ind.size(); i++) {
-      int y1, x1, y2, x2;
-      y1 = boxes.at(0 + i * 4) * (image_height - 1);
-      x1 = boxes.at(1 + i * 4) * (image_width - 1);
-      y2 = boxes.at(2 + i * 4) * (image_height - 1);
-      x2 = boxes.at(3 + i * 4) * (image_width - 1);
-
-      int crop_height = std::abs(y2 - y1);
-      int crop_width = std::abs(x2 - x1);
-
-      // account for flip crops when y1>y2 or x1>x2 with negative striding
-      int stride_height = 1, stride_width = 1;
-      if (y1 > y2) {
-        y1 = y1 - image_height;
-        y2 = y2 - image_height - 2;
-        stride_height = -1;
-      }
-      if (x1 > x2) {
-        x1 = x1 - image_height;
-        x2 = x2 - image_height - 2;
-        stride_width = -1;
-      }
+  auto boxes_shape = ng_boxes.get_partial_shape();
+  if (boxes_shape.rank().is_static() && boxes_shape.rank().get_length() > 0 &&
+      boxes_shape[0].is_static() && boxes_shape[0].get_length() == 0) {
+    SaveNgOp(ng_op_map, op->name(),
+             ConstructNgNode<opset::Constant>(
+                 op->name(), ov::element::f32,
+                 ov::Shape{0, static_cast<size_t>(crop_height),
+                           static_cast<size_t>(crop_width),
+                           static_cast<size_t>(image_depth)},
+                 std::vector<float>({})));
+    return Status::OK();
+  }
 
-      auto begin = ConstructNgNode<opset::Constant>(
-          op->name(), ov::element::i64, ov::Shape{4},
-          std::vector<int64>({static_cast<int64>(box_ind[i]), y1, x1, 0}));
-      auto end = ConstructNgNode<opset::Constant>(
-          op->name(), ov::element::i64, ov::Shape{4},
-          std::vector<int64>({static_cast<int64>(box_ind[i]) + 1, y2 + 1,
-                              x2 + 1, static_cast<int64>(image_depth + 1)}));
-      auto strides = ConstructNgNode<opset::Constant>(
-          op->name(), ov::element::i64, ov::Shape{4},
-          std::vector<int64>({1, stride_height, stride_width, 1}));
-
-      // crop
-      auto ng_crop = ConstructNgNode<opset::StridedSlice>(
-          op->name(), ng_input, begin, end, strides, std::vector<int64_t>{},
-          std::vector<int64_t>{});
-
-      opset::Interpolate::InterpolateAttrs interpolate_attrs;
-      // always corner aligned
-      interpolate_attrs.coordinate_transformation_mode =
-          opset::Interpolate::CoordinateTransformMode::ALIGN_CORNERS;
-
-      // TODO: handle the case when extrapolation value is greatger than 1.0
-      // arguments for resizing
-      auto ng_spatial_shape = ConstructNgNode<opset::Constant>(
-          op->name(), ov::element::i32, ov::Shape{2},
-          std::vector<int32>{crop_height, crop_width});
-      auto ng_input_shape = ConstructNgNode<opset::Convert>(
-          op->name(), ng_spatial_shape, ov::element::f32);
-      auto ng_crop_size = ConstructNgNode<opset::Convert>(op->name(), ng_size,
-                                                          ov::element::f32);
-      auto ng_scales = ConstructNgNode<opset::Divide>(op->name(), ng_crop_size,
-                                                      ng_input_shape);
-      auto ng_axes = ConstructNgNode<opset::Constant>(
-          op->name(), ov::element::i32, ov::Shape{2}, std::vector<int>({2, 3}));
-
-      if (tf_resize_method == "bilinear") {
-        interpolate_attrs.mode = opset::Interpolate::InterpolateMode::LINEAR;
-      } else {  // nearest
-        interpolate_attrs.mode = opset::Interpolate::InterpolateMode::NEAREST;
-      }
+  auto f32_scalar = [op](float value) {
+    return ConstructNgNode<opset::Constant>(op->name(), ov::element::f32,
+                                            ov::Shape{}, value);
+  };
+  auto unsqueeze = [op](ov::Output<ov::Node> node, std::vector<int64> axes) {
+    auto ng_axes = ConstructNgNode<opset::Constant>(
+        op->name(), ov::element::i64, ov::Shape{axes.size()}, axes);
+    return ConstructNgNode<opset::Unsqueeze>(op->name(), node, ng_axes);
+  };
 
-      Transpose<0, 3, 1, 2>(ng_crop);
-      auto ng_output = ConstructNgNode<opset::Interpolate>(
-          op->name(), ng_crop, ng_size, ng_scales, ng_axes, interpolate_attrs);
-      Transpose<0, 2, 3, 1>(ng_output);
-      ng_crop_outputs.at(i) = ng_output;
+  if (ng_input.get_element_type() != ov::element::f32) {
+    ng_input =
+        ConstructNgNode<opset::Convert>(op->name(), ng_input, ov::element::f32);
+  }
+  if (ng_boxes.get_element_type() != ov::element::f32) {
+    ng_boxes =
+        ConstructNgNode<opset::Convert>(op->name(), ng_boxes, ov::element::f32);
+  }
+  auto ng_image = ConstructNgNode<opset::Reshape>(
+      op->name(), ng_input,
+      ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                       ov::Shape{2},
+                                       std::vector<int64>{-1, image_depth}),
+      false);
+
+  // y1, x1, y2 and x2, each of shape [num_boxes, 1]
+  auto ng_split = ConstructNgNode<opset::Split>(
+      op->name(), ng_boxes,
+      ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                       ov::Shape{}, 1),
+      4);
+  auto ng_split_node = ng_split.get_node_shared_ptr();
+
+  // Sampling positions [num_boxes, crop_len] of a crop dim in the image dim
+  auto sample_positions = [&](ov::Output<ov::Node> start,
+                              ov::Output<ov::Node> end, int64 image_len,
+                              int64 crop_len) -> ov::Output<ov::Node> {
+    auto ng_image_scale = f32_scalar(static_cast<float>(image_len - 1));
+    if (crop_len == 1) {
+      auto ng_center = ConstructNgNode<opset::Multiply>(
+          op->name(), ConstructNgNode<opset::Add>(op->name(), start, end),
+          f32_scalar(0.5f));
+      return ConstructNgNode<opset::Multiply>(op->name(), ng_center,
+                                              ng_image_scale);
     }
+    std::vector<float> steps(crop_len);
+    std::iota(steps.begin(), steps.end(), 0.0f);
+    auto ng_steps = ConstructNgNode<opset::Constant>(
+        op->name(), ov::element::f32,
+        ov::Shape{1, static_cast<size_t>(crop_len)}, steps);
+    auto ng_step = ConstructNgNode<opset::Divide>(
+        op->name(),
+        ConstructNgNode<opset::Multiply>(
+            op->name(),
+            ConstructNgNode<opset::Subtract>(op->name(), end, start),
+            ng_image_scale),
+        f32_scalar(static_cast<float>(crop_len - 1)));
+    return ConstructNgNode<opset::Add>(
+        op->name(),
+        ConstructNgNode<opset::Multiply>(op->name(), start, ng_image_scale),
+        ConstructNgNode<opset::Multiply>(op->name(), ng_steps, ng_step));
+  };
+  auto in_y = sample_positions(ng_split_node->output(0),
+                               ng_split_node->output(2), image_height,
+                               crop_height);
+  auto in_x = sample_positions(ng_split_node->output(1),
+                               ng_split_node->output(3), image_width,
+                               crop_width);
+
+  // Samples outside of the image, shape [num_boxes, crop_height, crop_width,
+  // 1]
+  auto in_range = [&](ov::Output<ov::Node> pos, int64 image_len) {
+    return ConstructNgNode<opset::LogicalAnd>(
+        op->name(),
+        ConstructNgNode<opset::GreaterEqual>(op->name(), pos, f32_scalar(0.0f)),
+        ConstructNgNode<opset::LessEqual>(
+            op->name(), pos, f32_scalar(static_cast<float>(image_len - 1))));
+  };
+  auto ng_valid = ConstructNgNode<opset::LogicalAnd>(
+      op->name(), unsqueeze(in_range(in_y, image_height), {2, 3}),
+      unsqueeze(in_range(in_x, image_width), {1, 3}));
+
+  auto ng_batch_offsets = ConstructNgNode<opset::Multiply>(
+      op->name(),
+      unsqueeze(ConstructNgNode<opset::Convert>(op->name(), ng_box_ind,
+                                                ov::element::i32),
+                {1, 2}),
+      ConstructNgNode<opset::Constant>(
+          op->name(), ov::element::i32, ov::Shape{},
+          static_cast<int32>(image_height * image_width)));
+  auto to_index = [&](ov::Output<ov::Node> pos, int64 image_len) {
+    auto ng_clamped = ConstructNgNode<opset::Clamp>(
+        op->name(), pos, 0.0, static_cast<double>(image_len - 1));
+    return ConstructNgNode<opset::Convert>(op->name(), ng_clamped,
+                                           ov::element::i32);
+  };
+  // Pixels [num_boxes, crop_height, crop_width, depth] at the integral rows
+  // ys [num_boxes, crop_height] and columns xs [num_boxes, crop_width]
+  auto gather_pixels = [&](ov::Output<ov::Node> ys, ov::Output<ov::Node> xs) {
+    auto ng_rows = ConstructNgNode<opset::Multiply>(
+        op->name(), unsqueeze(to_index(ys, image_height), {2}),
+        ConstructNgNode<opset::Constant>(op->name(), ov::element::i32,
+                                         ov::Shape{},
+                                         static_cast<int32>(image_width)));
+    auto ng_indices = ConstructNgNode<opset::Add>(
+        op->name(),
+        ConstructNgNode<opset::Add>(op->name(), ng_batch_offsets, ng_rows),
+        unsqueeze(to_index(xs, image_width), {1}));
+    return ConstructNgNode<opset::Gather>(
+        op->name(), ng_image, ng_indices,
+        ConstructNgNode<opset::Constant>(op->name(), ov::element::i64,
+                                         ov::Shape{}, 0));
+  };
 
-    auto ng_crop_and_resize =
-        ConstructNgNode<opset::Concat>(op->name(), ng_crop_outputs, 0);
-
-    SaveNgOp(ng_op_map, op->name(), ng_crop_and_resize);
+  ov::Output<ov::Node> ng_crops;
+  if (tf_resize_method == "bilinear") {
+    auto top_y = ConstructNgNode<opset::Floor>(op->name(), in_y);
+    auto bottom_y = ConstructNgNode<opset::Ceiling>(op->name(), in_y);
+    auto left_x = ConstructNgNode<opset::Floor>(op->name(), in_x);
+    auto right_x = ConstructNgNode<opset::Ceiling>(op->name(), in_x);
+    auto y_lerp = unsqueeze(
+        ConstructNgNode<opset::Subtract>(op->name(), in_y, top_y), {2, 3});
+    auto x_lerp = unsqueeze(
+        ConstructNgNode<opset::Subtract>(op->name(), in_x, left_x), {1, 3});
+
+    auto lerp = [&](ov::Output<ov::Node> a, ov::Output<ov::Node> b,
+                    ov::Output<ov::Node> t) {
+      return ConstructNgNode<opset::Add>(
+          op->name(), a,
+          ConstructNgNode<opset::Multiply>(
+              op->name(), ConstructNgNode<opset::Subtract>(op->name(), b, a),
+              t));
+    };
+    auto top = lerp(gather_pixels(top_y, left_x),
+                    gather_pixels(top_y, right_x), x_lerp);
+    auto bottom = lerp(gather_pixels(bottom_y, left_x),
+                       gather_pixels(bottom_y, right_x), x_lerp);
+    ng_crops = lerp(top, bottom, y_lerp);
+  } else {  // nearest
+    auto round = [&](ov::Output<ov::Node> pos) {
+      return ConstructNgNode<opset::Round>(
+          op->name(), pos, opset::Round::RoundMode::HALF_AWAY_FROM_ZERO);
+    };
+    ng_crops = gather_pixels(round(in_y), round(in_x));
   }
+
+  auto ng_crop_and_resize = ConstructNgNode<opset::Select>(
+      op->name(), ng_valid, ng_crops, f32_scalar(tf_extrapolation_value));
+  SaveNgOp(ng_op_map, op->name(), ng_crop_and_resize);
   return Status::OK();
 }
 
@@ -3747,7 +3860,8 @@ Status Builder::TranslateGraph(
     const std::vector<const Tensor*>& static_input_map,
     const Graph* input_graph, const string name,
     shared_ptr<ov::Model>& ng_function, ov::ResultVector& ng_result_list,
-    const std::vector<Tensor>& tf_input_tensors) {
+    const std::vector<Tensor>& tf_input_tensors,
+    const std::vector<bool>& input_is_dynamic) {
   //
   // We will visit ops in topological order.
   //
@@ -3828,8 +3942,13 @@ Status Builder::TranslateGraph(
 
     string prov_tag;
     GetNodeAttr(parm->attrs(), "_prov_tag", &prov_tag);
+    // Inputs marked dynamic keep their rank but accept any dims
+    ov::PartialShape ng_partial_shape = ng_shape;
+    if (index < input_is_dynamic.size() && input_is_dynamic[index]) {
+      ng_partial_shape = ov::PartialShape::dynamic(ng_shape.size());
+    }
     auto ng_param =
-        ConstructNgNode<opset::Parameter>(prov_tag, ng_et, ng_shape);
+        ConstructNgNode<opset::Parameter>(prov_tag, ng_et, ng_partial_shape);
 
     auto ng_shape_check = [ng_shape]() {
       if (ng_shape.size() > 0) {
@@ -3978,15 +4097,16 @@ Status Builder::TranslateGraph(
   }
 
   auto param_dim_check = [ng_parameter_list](int i) {
-    auto param_shape_list = ng_parameter_list[i]->get_shape();
+    auto param_shape_list = ng_parameter_list[i]->get_partial_shape();
     for (auto dim : param_shape_list) {
-      if (dim == 0) return true;
+      if (dim.is_static() && dim.get_length() == 0) return true;
     }
     return false;
   };
 
   for (int i = 0; i < ng_parameter_list.size(); i++) {
-    if (!(ng_parameter_list[i]->get_shape().size() > 0 && param_dim_check(i))) {
+    if (!(ng_parameter_list[i]->get_partial_shape().rank().get_length() > 0 &&
+          param_dim_check(i))) {
       ng_func_parameter_list.push_back(ng_parameter_list[i]);
     }
   }
@@ -4028,7 +4148,12 @@ Status Builder::TranslateGraph(
     if (util::GetEnv("OPENVINO_TF_TRANSPOSE_SINKING") != "0") {
       passes.register_pass<pass::TransposeSinking>();
     }
-    passes.run_passes(ng_function);
+    try {
+      passes.run_passes(ng_function);
+    } catch (const std::exception& exp) {
+      return errors::Internal("Failed to run passes on OpenVINO Model for " +
+                              name + ": " + string(exp.what()));
+    }
   }
   OVTF_VLOG(5) << "Done with passes";
   //
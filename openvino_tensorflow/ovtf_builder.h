@@ -29,7 +29,8 @@ class Builder {
       const std::vector<const Tensor*>& static_input_map, const Graph* tf_graph,
       const string name, std::shared_ptr<ov::Model>& ng_function,
       ov::ResultVector& ng_func_result_list,
-      const std::vector<Tensor>& tf_input_tensors);
+      const std::vector<Tensor>& tf_input_tensors,
+      const std::vector<bool>& input_is_dynamic = {});
 
   using OpMap =
       std::unordered_map<std::string, std::vector<ov::Output<ov::Node>>>;
@@ -19,6 +19,7 @@
 #include "openvino_tensorflow/cluster_manager.h"
 #include "openvino_tensorflow/deassign_clusters.h"
 #include "openvino_tensorflow/encapsulate_clusters.h"
+#include "openvino_tensorflow/graph_shapes.h"
 #include "openvino_tensorflow/mark_for_clustering.h"
 #include "openvino_tensorflow/ovtf_utils.h"
 
@@ -194,13 +195,17 @@ class NGraphEncapsulationPass : public NGraphRewritePass {
     TF_RETURN_IF_ERROR(AssignClusters(graph));
     util::DumpTFGraph(graph, idx, "clustered");
 
+    // The shapes are inferred once, for the cost model of the deassignment and
+    // the warmup of the encapsulated clusters
+    GraphShapes shapes(*graph);
+
     // 3. Deassign trivial clusters then, if requested, dump the graphs.
-    TF_RETURN_IF_ERROR(DeassignClusters(graph));
+    TF_RETURN_IF_ERROR(DeassignClusters(graph, &shapes));
     util::DumpTFGraph(graph, idx, "declustered");
 
     // 4. Encapsulate clusters then, if requested, dump the graphs.
     std::unordered_map<std::string, std::string> config_map;
-    auto status = EncapsulateClusters(graph, idx, config_map);
+    auto status = EncapsulateClusters(graph, idx, config_map, &shapes);
     if (status != Status::OK()) {
       return status;
     }
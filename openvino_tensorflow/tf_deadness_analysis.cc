@@ -64,6 +64,8 @@ class Predicate {
     return !(*this == other);
   }
   int64 hash() const { return hash_; }
+  // Dense id assigned when the PredicateFactory interns the predicate
+  int id() const { return id_; }
   virtual Kind kind() const = 0;
   virtual ~Predicate() {}
 
@@ -71,7 +73,9 @@ class Predicate {
   explicit Predicate(int64 hash) : hash_(hash) {}
 
  private:
+  friend class PredicateFactory;
   const int64 hash_;
+  int id_ = -1;
 };
 int64 HashPredicateSequence(Predicate::Kind kind,
                             gtl::ArraySlice<Predicate*> preds) {
@@ -81,13 +85,15 @@ int64 HashPredicateSequence(Predicate::Kind kind,
   }
   return hash;
 }
+// The operands are interned by the PredicateFactory, so equal operands are
+// the same instance
 bool PredicateSequenceEqual(gtl::ArraySlice<Predicate*> lhs,
                             gtl::ArraySlice<Predicate*> rhs) {
   if (lhs.size() != rhs.size()) {
     return false;
   }
   for (size_t i = 0; i < lhs.size(); i++) {
-    if (*lhs[i] != *rhs[i]) {
+    if (lhs[i] != rhs[i]) {
       return false;
     }
   }
@@ -162,7 +168,7 @@ class NotPredicate : public Predicate {
   }
   bool operator==(const Predicate& other) const override {
     return other.kind() == Kind::kNot &&
-           *dynamic_cast<const NotPredicate&>(other).operand() == *operand();
+           dynamic_cast<const NotPredicate&>(other).operand() == operand();
   }
   Kind kind() const override { return Kind::kNot; }
   Predicate* operand() const { return operand_; }
@@ -208,7 +214,8 @@ class SymbolPredicate : public Predicate {
   }
 };
 // Creates and owns Predicate instances.  Simplifies predicates as it creates
-// them.
+// them, and hash-conses them: equal predicates are the same instance, so they
+// compare by pointer or by id.
 class PredicateFactory {
  public:
   Predicate* MakeAndPredicate(gtl::ArraySlice<Predicate*> operands) {
@@ -226,12 +233,21 @@ class PredicateFactory {
   Predicate* MakeTrue() { return MakeAndPredicate({}); }
   Predicate* MakeFalse() { return MakeOrPredicate({}); }
 
+  // The predicate interned with the id
+  Predicate* Get(int id) const { return predicate_storage_[id].get(); }
+
  private:
   template <typename PredicateT, typename... Args>
   Predicate* Make(Args... args) {
     std::unique_ptr<PredicateT> pred(
         new PredicateT(std::forward<Args>(args)...));
+    auto it = interned_.find(pred.get());
+    if (it != interned_.end()) {
+      return *it;
+    }
+    pred->id_ = predicate_storage_.size();
     predicate_storage_.emplace_back(std::move(pred));
+    interned_.insert(predicate_storage_.back().get());
     return predicate_storage_.back().get();
   }
   Predicate* MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands, bool is_and);
@@ -245,7 +261,9 @@ class PredicateFactory {
   };
   using PredicateSet =
       gtl::FlatSet<Predicate*, PredicatePtrHash, PredicatePtrEq>;
+  // Indexed by id
   std::vector<std::unique_ptr<Predicate>> predicate_storage_;
+  PredicateSet interned_;
 };
 // Common code to create AndPredicate or OrPredicate instances.
 Predicate* PredicateFactory::MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands,
@@ -288,9 +306,13 @@ Predicate* PredicateFactory::MakeAndOrImpl(gtl::ArraySlice<Predicate*> operands,
       return is_and ? MakeFalse() : MakeTrue();
     }
   }
-  std::stable_sort(
-      simplified_ops.begin(), simplified_ops.end(),
-      [](Predicate* a, Predicate* b) { return a->hash() < b->hash(); });
+  // Operands with colliding hashes are ordered by id, so that equal operand
+  // sets give the same interned predicate
+  std::sort(simplified_ops.begin(), simplified_ops.end(),
+            [](Predicate* a, Predicate* b) {
+              return a->hash() != b->hash() ? a->hash() < b->hash()
+                                            : a->id() < b->id();
+            });
   return is_and ? Make<AndPredicate>(std::move(simplified_ops))
                 : Make<OrPredicate>(std::move(simplified_ops));
 }
@@ -302,6 +324,9 @@ class DeadnessAnalysisImpl : public DeadnessAnalysis {
   bool HasInputsWithMismatchingDeadness(const Node& node) override;
   void Print() const override;
   Status GetNodePredicate(const Node& node, string& pred_string) override;
+  Status GetNodePredicate(const Node& node, PredicateHandle& pred) override;
+  bool IsTruePredicate(PredicateHandle pred) const override;
+  string PredicateString(PredicateHandle pred) const override;
 
  private:
   enum class EdgeKind { kDataAndControl, kDataOnly, kControlOnly };
@@ -322,6 +347,7 @@ class DeadnessAnalysisImpl : public DeadnessAnalysis {
   const Graph& graph_;
   gtl::FlatMap<TensorId, Predicate*, TensorId::Hasher> predicate_map_;
   PredicateFactory predicate_factory_;
+  PredicateHandle true_predicate_ = kNoPredicate;
   bool vlog_;
 };
 TensorId InputEdgeToTensorId(const Edge* e) {
@@ -404,6 +430,7 @@ Status DeadnessAnalysisImpl::HandleGeneric(Node* n) {
   return Status::OK();
 }
 Status DeadnessAnalysisImpl::Populate() {
+  true_predicate_ = predicate_factory_.MakeTrue()->id();
   std::vector<Node*> rpo;
   GetReversePostOrder(graph_, &rpo, /*stable_comparator=*/{},
                       /*edge_filter=*/[](const Edge& edge) {
@@ -442,7 +469,7 @@ bool DeadnessAnalysisImpl::HasInputsWithMismatchingDeadness(const Node& node) {
     // Today we just compare the predicates for equality (with some
     // canonicalization/simplification happening before) but we could be more
     // sophisticated here if need be.
-    if (pred != nullptr && *pred != *it->second) {
+    if (pred != nullptr && pred != it->second) {
       if (vlog_) {
         VLOG(2) << "HasInputsWithMismatchingDeadness(" << node.name()
                 << ") -> true";
@@ -460,8 +487,19 @@ bool DeadnessAnalysisImpl::HasInputsWithMismatchingDeadness(const Node& node) {
 
 Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
                                               string& pred_string) {
+  PredicateHandle pred;
+  TF_RETURN_IF_ERROR(GetNodePredicate(node, pred));
+  // Nodes without outputs keep the string they were given
+  if (pred != kNoPredicate) {
+    pred_string = PredicateString(pred);
+  }
+  return Status::OK();
+}
+
+Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
+                                              PredicateHandle& pred_handle) {
   if (node.IsSource() || node.IsSink() || node.IsControlFlow()) {
-    DeadnessAnalysis::GetControlFlowPredString(pred_string);
+    pred_handle = kControlFlowPredicate;
     return Status::OK();
   }
 
@@ -471,7 +509,7 @@ Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
     CHECK(it != predicate_map_.end()) << edge->DebugString();
 
     // This node is not control flow but has different output predicates
-    if (pred != nullptr && *pred != *it->second) {
+    if (pred != nullptr && pred != it->second) {
       return errors::Internal(node.name(), "[", node.type_string(), "]",
                               " is a non control flow op. But its outputs have "
                               "different predicates");
@@ -480,12 +518,24 @@ Status DeadnessAnalysisImpl::GetNodePredicate(const Node& node,
   }
 
   // All outputs have the same predicate
-  if (pred != nullptr) {
-    pred_string = pred->ToString();
-  }
+  pred_handle = pred != nullptr ? pred->id() : kNoPredicate;
   return Status::OK();
 }
 
+bool DeadnessAnalysisImpl::IsTruePredicate(PredicateHandle pred) const {
+  return pred == true_predicate_;
+}
+
+string DeadnessAnalysisImpl::PredicateString(PredicateHandle pred) const {
+  if (pred == kControlFlowPredicate) {
+    string pred_string;
+    DeadnessAnalysis::GetControlFlowPredString(pred_string);
+    return pred_string;
+  }
+  if (pred == kNoPredicate) return "";
+  return predicate_factory_.Get(pred)->ToString();
+}
+
 void DeadnessAnalysisImpl::Print() const {
   std::vector<TensorId> tensor_ids;
   for (const auto& kv_pair : predicate_map_) {
@@ -514,6 +564,11 @@ DeadnessAnalysis::~DeadnessAnalysis() {}
   return Status::OK();
 }
 
+/*static*/ constexpr DeadnessAnalysis::PredicateHandle
+    DeadnessAnalysis::kControlFlowPredicate;
+/*static*/ constexpr DeadnessAnalysis::PredicateHandle
+    DeadnessAnalysis::kNoPredicate;
+
 /*static*/ const std::string DeadnessAnalysis::CONTROL_FLOW_PRED_STRING =
     "#control_flow";
 // Same as the True predicate used in AndPredicate
@@ -85,6 +85,25 @@ class DeadnessAnalysis {
   // assigned a placeholder predicate string (CONTROL_FLOW_PRED_STRING) .
   virtual Status GetNodePredicate(const Node& node, string& pred_string) = 0;
 
+  // Handle of a predicate of this analysis. Predicates are hash-consed, so
+  // two nodes have the same predicate iff their handles are equal, and
+  // comparing them does not build any predicate string.
+  using PredicateHandle = int;
+  // Handle given to control flow ops, see CONTROL_FLOW_PRED_STRING
+  static constexpr PredicateHandle kControlFlowPredicate = -1;
+  // Handle given to nodes without outputs
+  static constexpr PredicateHandle kNoPredicate = -2;
+
+  // Same as above, without building the predicate string
+  virtual Status GetNodePredicate(const Node& node, PredicateHandle& pred) = 0;
+  virtual bool IsTruePredicate(PredicateHandle pred) const = 0;
+  // The predicate string of the handle, for logging
+  virtual string PredicateString(PredicateHandle pred) const = 0;
+
+  inline static bool IsControlFlowPredicate(PredicateHandle pred) {
+    return pred == kControlFlowPredicate;
+  }
+
   inline static bool IsControlFlowPredString(const string& predicate) {
     return CONTROL_FLOW_PRED_STRING == predicate;
   }
@@ -379,7 +379,7 @@ bool GraphCycles::CanContractEdge(int32 a, int32 b) {
   return !reachable;
 }
 
-bool GraphCycles::ContractEdge(int32 a, int32 b) {
+bool GraphCycles::ContractEdge(int32 a, int32 b, int32* merged) {
   CHECK(HasEdge(a, b));
   RemoveEdge(a, b);
 
@@ -389,7 +389,15 @@ bool GraphCycles::ContractEdge(int32 a, int32 b) {
     return false;
   }
 
+  Node* na = rep_->nodes_[a];
   Node* nb = rep_->nodes_[b];
+  if (nb->in.size() + nb->out.size() > na->in.size() + na->out.size()) {
+    // Swap "a" and "b" to minimize copying.
+    std::swap(a, b);
+    nb = na;
+  }
+  *merged = a;
+
   std::unordered_set<int32> out = std::move(nb->out);
   std::unordered_set<int32> in = std::move(nb->in);
   for (auto y : out) {
@@ -89,11 +89,12 @@ class GraphCycles {
   // Return whether there is an edge directly from source_node to dest_node.
   bool HasEdge(int32 source_node, int32 dest_node) const;
 
-  // Contracts the edge from 'a' to node 'b', merging nodes 'a' and 'b'. 'b' is
-  // removed from the graph, and edges to/from 'b' are replaced with edges
-  // to/from 'a'. If contracting the edge would create a cycle, does nothing
+  // Contracts the edge from 'a' to node 'b', merging nodes 'a' and 'b'. The
+  // node with fewer edges is removed from the graph, and its edges are
+  // replaced with edges to/from the other one, which is returned in
+  // 'merged'. If contracting the edge would create a cycle, does nothing
   // and returns false.
-  bool ContractEdge(int32 a, int32 b);
+  bool ContractEdge(int32 a, int32 b, int32* merged);
 
   // Return true if can contract edge, otherwise return false.
   bool CanContractEdge(int32 a, int32 b);
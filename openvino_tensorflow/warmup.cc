@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <chrono>
+
+#include "absl/strings/match.h"
+#include "tensorflow/core/common_runtime/shape_refiner.h"
+#include "tensorflow/core/framework/shape_inference.h"
+#include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/graph/algorithm.h"
+#include "tensorflow/core/graph/tensor_id.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+
+#include "logging/ovtf_log.h"
+#include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/warmup.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+std::mutex WarmupRegistry::s_mutex;
+std::condition_variable WarmupRegistry::s_complete;
+std::vector<WarmupRegistry::Signature> WarmupRegistry::s_signatures;
+bool WarmupRegistry::s_annotated = false;
+int64 WarmupRegistry::s_pending = 0;
+
+namespace {
+
+// Returns the output of the node a declared input name refers to, or -1.
+// Fed tensors are replaced by _Arg nodes named
+// _arg_<node>_<output>_<index> in session graphs.
+int DeclaredOutput(const Node* node, const std::string& input_name) {
+  TensorId tensor_id = ParseTensorName(input_name);
+  string node_name(tensor_id.first);
+  if (node->name() == node_name) return tensor_id.second;
+  if (node->IsArg() &&
+      absl::StartsWith(node->name(), strings::StrCat("_arg_", node_name, "_",
+                                                     tensor_id.second, "_"))) {
+    return 0;
+  }
+  return -1;
+}
+
+// Infers the input shapes of the encapsulate nodes for one signature.
+// Nodes with an input whose shape is not fully defined are left out.
+Status InferClusterInputShapes(
+    Graph* graph, const std::vector<Node*>& ordered,
+    const WarmupRegistry::Signature& signature,
+    std::map<Node*, std::vector<PartialTensorShape>>& cluster_shapes,
+    bool& found_inputs) {
+  ShapeRefiner refiner(graph->versions(), graph->op_registry());
+  refiner.set_require_shape_inference_fns(false);
+  for (auto node : ordered) {
+    if (node->IsSource() || node->IsSink()) continue;
+    TF_RETURN_IF_ERROR(refiner.AddNode(node));
+
+    bool declared = false;
+    for (const auto& input : signature) {
+      int output = DeclaredOutput(node, input.first);
+      if (output < 0 || output >= node->num_outputs()) continue;
+      auto context = refiner.GetContext(node);
+      shape_inference::ShapeHandle shape;
+      TF_RETURN_IF_ERROR(
+          context->MakeShapeFromTensorShape(input.second, &shape));
+      TF_RETURN_IF_ERROR(refiner.SetShape(node, output, shape));
+      found_inputs = declared = true;
+    }
+    // Function arguments carry their shapes as an attribute, which the shape
+    // function of _Arg ignores
+    std::vector<PartialTensorShape> output_shapes;
+    if (!declared && node->IsArg() &&
+        GetNodeAttr(node->attrs(), "_output_shapes", &output_shapes).ok() &&
+        output_shapes.size() == 1 && output_shapes[0].IsFullyDefined()) {
+      auto context = refiner.GetContext(node);
+      shape_inference::ShapeHandle shape;
+      TF_RETURN_IF_ERROR(
+          context->MakeShapeFromPartialTensorShape(output_shapes[0], &shape));
+      TF_RETURN_IF_ERROR(refiner.SetShape(node, 0, shape));
+    }
+
+    if (node->type_string() != "_nGraphEncapsulate" ||
+        node->num_inputs() == 0) {
+      continue;
+    }
+    std::vector<PartialTensorShape> input_shapes;
+    for (int i = 0; i < node->num_inputs(); i++) {
+      const Edge* edge;
+      TF_RETURN_IF_ERROR(node->input_edge(i, &edge));
+      auto context = refiner.GetContext(edge->src());
+      auto shape = context->output(edge->src_output());
+      if (!context->FullyDefined(shape)) {
+        OVTF_VLOG(1) << "Input " << i << " of " << node->name()
+                     << " has an unknown shape, it is not warmed up";
+        input_shapes.clear();
+        break;
+      }
+      TensorShapeProto shape_proto;
+      context->ShapeHandleToProto(shape, &shape_proto);
+      input_shapes.emplace_back(shape_proto);
+    }
+    auto& shapes = cluster_shapes[node];
+    shapes.insert(shapes.end(), input_shapes.begin(), input_shapes.end());
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+void WarmupRegistry::SetSignatures(const std::vector<Signature>& signatures) {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_signatures = signatures;
+  s_annotated = false;
+  s_complete.notify_all();
+}
+
+bool WarmupRegistry::HasSignatures() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return !s_signatures.empty();
+}
+
+Status WarmupRegistry::AnnotateGraph(
+    Graph* graph, const std::map<Node*, std::vector<PartialTensorShape>>*
+                      graph_input_shapes) {
+  std::vector<Signature> signatures;
+  {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    signatures = s_signatures;
+  }
+  bool declared = !signatures.empty();
+  if (!declared) {
+    if (util::GetEnv("OPENVINO_TF_PARALLEL_COMPILE") == "0") {
+      return Status::OK();
+    }
+    // Without declared shapes, the clusters whose input shapes are fixed by
+    // the graph itself are compiled ahead
+    signatures.emplace_back();
+  }
+
+  std::map<Node*, std::vector<PartialTensorShape>> cluster_shapes;
+  bool found_inputs = false;
+  if (!declared && graph_input_shapes != nullptr) {
+    // The shapes the rewrite inferred before encapsulation are reused
+    for (const auto& node_shapes : *graph_input_shapes) {
+      bool fully_defined = !node_shapes.second.empty();
+      for (const auto& shape : node_shapes.second) {
+        fully_defined &= shape.IsFullyDefined();
+      }
+      if (fully_defined) {
+        cluster_shapes[node_shapes.first] = node_shapes.second;
+      } else {
+        OVTF_VLOG(1) << "An input of " << node_shapes.first->name()
+                     << " has an unknown shape, it is not warmed up";
+      }
+    }
+  } else {
+    std::vector<Node*> ordered;
+    GetReversePostOrder(*graph, &ordered, NodeComparatorName());
+    for (const auto& signature : signatures) {
+      TF_RETURN_IF_ERROR(InferClusterInputShapes(
+          graph, ordered, signature, cluster_shapes, found_inputs));
+    }
+  }
+  // Graphs without the declared inputs, like the functions of other models,
+  // do not complete the warmup
+  if (declared && !found_inputs) return Status::OK();
+
+  int64 num_compilations = 0;
+  for (const auto& node_shapes : cluster_shapes) {
+    if (node_shapes.second.empty()) continue;
+    node_shapes.first->AddAttr(kWarmupShapesAttr, node_shapes.second);
+    num_compilations +=
+        node_shapes.second.size() / node_shapes.first->num_inputs();
+  }
+  OVTF_VLOG(1) << "Compiling " << num_compilations
+               << " cluster signatures ahead";
+
+  std::lock_guard<std::mutex> lock(s_mutex);
+  if (declared) s_annotated = true;
+  s_complete.notify_all();
+  return Status::OK();
+}
+
+void WarmupRegistry::CompilationsQueued(int64 count) {
+  if (count == 0) return;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_pending += count;
+}
+
+void WarmupRegistry::CompilationsDone(int64 count) {
+  if (count == 0) return;
+  std::lock_guard<std::mutex> lock(s_mutex);
+  s_pending -= count;
+  s_complete.notify_all();
+}
+
+bool WarmupRegistry::IsComplete() {
+  std::lock_guard<std::mutex> lock(s_mutex);
+  return s_signatures.empty() || (s_annotated && s_pending <= 0);
+}
+
+bool WarmupRegistry::Wait(int64 timeout_ms) {
+  std::unique_lock<std::mutex> lock(s_mutex);
+  auto settled = []() {
+    return s_signatures.empty() || !s_annotated || s_pending <= 0;
+  };
+  if (timeout_ms < 0) {
+    s_complete.wait(lock, settled);
+  } else {
+    s_complete.wait_for(lock, std::chrono::milliseconds(timeout_ms), settled);
+  }
+  return s_signatures.empty() || (s_annotated && s_pending <= 0);
+}
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
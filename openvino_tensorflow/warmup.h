@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#ifndef OPENVINO_TF_WARMUP_H_
+#define OPENVINO_TF_WARMUP_H_
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+
+// Name of the _nGraphEncapsulate attribute holding the input shapes to
+// compile ahead of time, the shapes of all inputs for each signature in turn
+constexpr char kWarmupShapesAttr[] = "_ovtf_warmup_shapes";
+
+// Input shapes declared through api::Warmup before the graph is rewritten.
+// Each signature maps graph inputs, the tensors fed to a session or the
+// arguments of a function, to the shapes to compile for.
+//
+// After encapsulation the declared shapes are propagated through the graph
+// and the input shapes they imply for each cluster are attached to its
+// encapsulate node. The kernels queue these compilations on the
+// CompileScheduler when they are created, so all clusters compile in
+// parallel before the first inference. Without declared shapes, the same is
+// done for the clusters whose input shapes the graph fixes, unless
+// OPENVINO_TF_PARALLEL_COMPILE is 0.
+//
+// The graph is rewritten and its kernels are created when a session first
+// runs it or creates a callable for it, and when a function is first
+// called. The warmup is not complete before that.
+class WarmupRegistry {
+ public:
+  using Signature = std::map<std::string, TensorShape>;
+
+  // Reports a queued warmup compilation as done when destroyed, whether the
+  // job ran or was dropped
+  struct PendingCompilation {
+    ~PendingCompilation() { CompilationsDone(1); }
+  };
+
+  static void SetSignatures(const std::vector<Signature>& signatures);
+  static bool HasSignatures();
+  // Attaches the cluster input shapes of the declared signatures, or of the
+  // graph, to the encapsulate nodes. Clusters whose input shapes are not
+  // fully known for a signature are not compiled ahead for it. The input
+  // shapes of the graph are inferred unless given by encapsulate node.
+  static Status AnnotateGraph(
+      Graph* graph,
+      const std::map<Node*, std::vector<PartialTensorShape>>*
+          graph_input_shapes = nullptr);
+
+  // Reports the warmup compilations a kernel is about to queue
+  static void CompilationsQueued(int64 count);
+  // Reports warmup compilations that finished or were skipped
+  static void CompilationsDone(int64 count);
+  // True unless compilations of the declared signatures are outstanding, or
+  // no graph has been rewritten since they were declared
+  static bool IsComplete();
+  // Waits up to timeout_ms, forever if negative, for IsComplete. Returns
+  // false right away if no graph has been rewritten since the signatures
+  // were declared, there is nothing to wait for yet.
+  static bool Wait(int64 timeout_ms);
+
+ private:
+  static std::mutex s_mutex;
+  static std::condition_variable s_complete;
+  static std::vector<Signature> s_signatures;
+  static bool s_annotated;
+  static int64 s_pending;
+};
+
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
+
+#endif  // OPENVINO_TF_WARMUP_H_
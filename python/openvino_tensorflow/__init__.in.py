@@ -44,7 +44,11 @@ __all__ = [
     'is_grappler_enabled', 'update_config',
     'set_disabled_ops', 'get_disabled_ops',
     'enable_dynamic_fallback', 'disable_dynamic_fallback',
-    'export_ir',
+    'export_ir', 'set_model_cache_dir',
+    'set_executable_cache_limit', 'get_executable_cache_stats',
+    'get_execution_stats',
+    'warmup', 'is_warmup_complete', 'wait_for_warmup',
+    'get_compile_progress', 'set_compile_property',
 ]
 
 if system() == 'Darwin':
@@ -137,6 +141,18 @@ if ovtf_classic_loaded:
     openvino_tensorflow_lib.freeClusterInfo.restype = ctypes.c_void_p
     openvino_tensorflow_lib.freeErrMsg.argtypes = []
     openvino_tensorflow_lib.freeErrMsg.restype = ctypes.c_void_p
+    openvino_tensorflow_lib.set_model_cache_dir.argtypes = [ctypes.c_char_p]
+    openvino_tensorflow_lib.set_executable_cache_limit.argtypes = [ctypes.c_int64]
+    openvino_tensorflow_lib.get_executable_cache_stats.argtypes = [ctypes.POINTER(ctypes.c_int64)]
+    openvino_tensorflow_lib.get_execution_stats.argtypes = [ctypes.POINTER(ctypes.c_int64)]
+    openvino_tensorflow_lib.warmup.argtypes = [ctypes.c_int, ctypes.POINTER(ctypes.c_char_p), ctypes.c_int, ctypes.POINTER(ctypes.c_int), ctypes.POINTER(ctypes.c_int64)]
+    openvino_tensorflow_lib.warmup.restype = ctypes.c_bool
+    openvino_tensorflow_lib.is_warmup_complete.restype = ctypes.c_bool
+    openvino_tensorflow_lib.wait_for_warmup.argtypes = [ctypes.c_int64]
+    openvino_tensorflow_lib.wait_for_warmup.restype = ctypes.c_bool
+    openvino_tensorflow_lib.get_compile_progress.argtypes = [ctypes.POINTER(ctypes.c_int64)]
+    openvino_tensorflow_lib.set_compile_property.argtypes = [ctypes.c_char_p, ctypes.c_char_p]
+    openvino_tensorflow_lib.set_compile_property.restype = ctypes.c_bool
 
     def enable():
         openvino_tensorflow_lib.enable()
@@ -194,7 +210,7 @@ if ovtf_classic_loaded:
     def is_grappler_enabled():
         return openvino_tensorflow_lib.is_grappler_enabled()
 
-    def update_config(config, backend_name = "CPU", device_id = ""):
+    def update_config(config, backend_name = "CPU", device_id = "", compile_properties = None):
         #updating session config if grappler is enabled
         if(openvino_tensorflow_lib.is_grappler_enabled()):
             opt_name = 'ovtf-optimizer'
@@ -211,6 +227,11 @@ if ovtf_classic_loaded:
             ovtf_optimizer = rewriter_options.custom_optimizers.add()
             ovtf_optimizer.name = opt_name
             ovtf_optimizer.parameter_map["device_id"].s = device_id.encode()
+            # OpenVINO compile properties of the clusters of this graph, e.g.
+            # {"performance_mode": "THROUGHPUT", "num_streams": 4}
+            if compile_properties:
+                for name, value in compile_properties.items():
+                    ovtf_optimizer.parameter_map[name].s = str(value).encode()
             config.MergeFrom(tf.compat.v1.ConfigProto(graph_options=tf.compat.v1.GraphOptions(rewrite_options=rewriter_options)))
             # For reference, if we want to provide configuration support(backend parameters)
             # in a python script using the ovtf-optimizer
@@ -249,6 +270,65 @@ if ovtf_classic_loaded:
 
         return cluster_string
 
+    def set_model_cache_dir(cache_dir):
+        openvino_tensorflow_lib.set_model_cache_dir(cache_dir.encode("utf-8"))
+
+    def set_executable_cache_limit(limit_mb):
+        openvino_tensorflow_lib.set_executable_cache_limit(limit_mb)
+
+    def get_executable_cache_stats():
+        keys = ['num_entries', 'size_bytes', 'limit_bytes', 'hits', 'misses',
+                'insertions', 'evictions', 'evicted_bytes']
+        values = (ctypes.c_int64 * len(keys))()
+        openvino_tensorflow_lib.get_executable_cache_stats(values)
+        return dict(zip(keys, values))
+
+    def get_execution_stats():
+        keys = ['template_reshapes', 'split_inferences', 'micro_batches',
+                'micro_batched_calls', 'lean_executables']
+        values = (ctypes.c_int64 * len(keys))()
+        openvino_tensorflow_lib.get_execution_stats(values)
+        return dict(zip(keys, values))
+
+    def set_compile_property(name, value):
+        if not openvino_tensorflow_lib.set_compile_property(
+                name.encode("utf-8"), str(value).encode("utf-8")):
+            raise ValueError("Unknown compile property: " + name)
+
+    def warmup(input_shapes):
+        # input_shapes maps each graph input name to the list of its shapes,
+        # the i-th shapes of all inputs form the i-th signature
+        names = list(input_shapes.keys())
+        num_signatures = len(input_shapes[names[0]]) if names else 0
+        if any(len(shapes) != num_signatures for shapes in input_shapes.values()):
+            raise ValueError("Every input needs the same number of shapes")
+        ranks = []
+        dims = []
+        for k in range(num_signatures):
+            for name in names:
+                shape = list(input_shapes[name][k])
+                ranks.append(len(shape))
+                dims.extend(shape)
+        c_names = (ctypes.c_char_p * len(names))(
+            *[name.encode("utf-8") for name in names])
+        c_ranks = (ctypes.c_int * len(ranks))(*ranks)
+        c_dims = (ctypes.c_int64 * len(dims))(*dims)
+        if not openvino_tensorflow_lib.warmup(len(names), c_names,
+                                              num_signatures, c_ranks, c_dims):
+            raise ValueError("Invalid warmup shapes")
+
+    def is_warmup_complete():
+        return openvino_tensorflow_lib.is_warmup_complete()
+
+    def wait_for_warmup(timeout_ms=-1):
+        return openvino_tensorflow_lib.wait_for_warmup(timeout_ms)
+
+    def get_compile_progress():
+        keys = ['queued', 'running', 'completed', 'failed', 'dropped']
+        values = (ctypes.c_int64 * len(keys))()
+        openvino_tensorflow_lib.get_compile_progress(values)
+        return dict(zip(keys, values))
+
     __version__ = \
     "OpenVINO integration with TensorFlow version: " + str(openvino_tensorflow_lib.version()) + "\n" + \
     "OpenVINO version used for this build: " + str(openvino_tensorflow_lib.openvino_version()) + "\n" + \
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/backend_selector.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+using Backend = BackendSelector::Backend;
+
+static InputSignature MakeSignature(int64 batch) {
+  InputSignature signature;
+  std::vector<Tensor> inputs = {Tensor(DT_FLOAT, TensorShape({batch, 4}))};
+  EXPECT_EQ(signature.Compute(inputs, {false}), Status::OK());
+  return signature;
+}
+
+// Runs calls of the signature until it is pinned, timing each backend at
+// the given cost
+static void Sample(BackendSelector& selector, const InputSignature& signature,
+                   int64 openvino_us, int64 tf_us) {
+  Backend backend;
+  for (int i = 0; i < 100 && !selector.GetPinned(signature, backend); i++) {
+    bool sample;
+    backend = selector.Select(signature, sample);
+    ASSERT_TRUE(sample);
+    selector.Record(signature, backend,
+                    backend == Backend::kOpenVINO ? openvino_us : tf_us);
+  }
+}
+
+TEST(BackendSelector, AlternatesWhileSampling) {
+  BackendSelector selector(2, 100);
+  auto signature = MakeSignature(1);
+  bool sample;
+  // Untimed first call on each side
+  ASSERT_EQ(selector.Select(signature, sample), Backend::kOpenVINO);
+  EXPECT_TRUE(sample);
+  selector.Record(signature, Backend::kOpenVINO, 1000000);
+  ASSERT_EQ(selector.Select(signature, sample), Backend::kOpenVINO);
+  selector.Record(signature, Backend::kOpenVINO, 10);
+  ASSERT_EQ(selector.Select(signature, sample), Backend::kTF);
+  selector.Record(signature, Backend::kTF, 1000000);
+  ASSERT_EQ(selector.Select(signature, sample), Backend::kTF);
+  selector.Record(signature, Backend::kTF, 20);
+  EXPECT_EQ(selector.Select(signature, sample), Backend::kOpenVINO);
+}
+
+TEST(BackendSelector, PinsTheFasterBackendPerSignature) {
+  BackendSelector selector(3, 100);
+  auto small_batch = MakeSignature(1);
+  auto large_batch = MakeSignature(64);
+  Sample(selector, small_batch, 100, 40);
+  Sample(selector, large_batch, 100, 400);
+
+  Backend backend;
+  ASSERT_TRUE(selector.GetPinned(small_batch, backend));
+  EXPECT_EQ(backend, Backend::kTF);
+  ASSERT_TRUE(selector.GetPinned(large_batch, backend));
+  EXPECT_EQ(backend, Backend::kOpenVINO);
+
+  bool sample;
+  EXPECT_EQ(selector.Select(small_batch, sample), Backend::kTF);
+  EXPECT_FALSE(sample);
+}
+
+TEST(BackendSelector, ResamplesPinnedSignatures) {
+  BackendSelector selector(1, 10);
+  auto signature = MakeSignature(8);
+  Sample(selector, signature, 100, 40);
+
+  bool sample;
+  for (int i = 0; i < 9; i++) {
+    EXPECT_EQ(selector.Select(signature, sample), Backend::kTF);
+    EXPECT_FALSE(sample);
+  }
+  // Both sides are warm, one timed call each settles it again
+  EXPECT_EQ(selector.Select(signature, sample), Backend::kOpenVINO);
+  EXPECT_TRUE(sample);
+  selector.Record(signature, Backend::kOpenVINO, 10);
+  EXPECT_EQ(selector.Select(signature, sample), Backend::kTF);
+  selector.Record(signature, Backend::kTF, 40);
+
+  Backend backend;
+  ASSERT_TRUE(selector.GetPinned(signature, backend));
+  EXPECT_EQ(backend, Backend::kOpenVINO);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
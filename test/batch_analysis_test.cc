@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/batch_analysis.h"
+#include "openvino_tensorflow/default_opset.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static shared_ptr<opset::Parameter> MakeParameter(const ov::Shape& shape) {
+  return make_shared<opset::Parameter>(ov::element::f32, shape);
+}
+
+static shared_ptr<opset::Constant> MakeAxes(const vector<int64_t>& axes) {
+  return opset::Constant::create(ov::element::i64, ov::Shape{axes.size()},
+                                 axes);
+}
+
+static bool RowsAreIndependent(const ov::OutputVector& outputs,
+                               const ov::ParameterVector& params) {
+  ov::ResultVector results;
+  for (const auto& output : outputs) {
+    results.push_back(make_shared<opset::Result>(output));
+  }
+  string reason;
+  bool independent = BatchAnalysis::RowsAreIndependent(
+      make_shared<ov::Model>(results, params), reason);
+  EXPECT_EQ(independent, reason.empty()) << reason;
+  return independent;
+}
+
+TEST(BatchAnalysis, AcceptsRowWiseOps) {
+  auto x = MakeParameter({8, 16});
+  auto weights = opset::Constant::create(ov::element::f32, ov::Shape{16, 4},
+                                         vector<float>(64, 0.5f));
+  auto matmul = make_shared<opset::MatMul>(x, weights);
+  auto relu = make_shared<opset::Relu>(matmul);
+  auto softmax = make_shared<opset::Softmax>(relu, 1);
+  auto mean = make_shared<opset::ReduceMean>(x, MakeAxes({1}), true);
+  EXPECT_TRUE(RowsAreIndependent({softmax, mean}, {x}));
+}
+
+TEST(BatchAnalysis, RejectsBatchReductions) {
+  auto x = MakeParameter({8, 16});
+  auto mean = make_shared<opset::ReduceMean>(x, MakeAxes({0}), false);
+  EXPECT_FALSE(RowsAreIndependent({mean}, {x}));
+
+  // The shape is kept, but every row depends on the others
+  auto y = MakeParameter({8, 16});
+  auto sum = make_shared<opset::ReduceSum>(y, MakeAxes({0}), true);
+  auto centered = make_shared<opset::Subtract>(y, sum);
+  EXPECT_FALSE(RowsAreIndependent({centered}, {y}));
+}
+
+TEST(BatchAnalysis, RejectsOpsAlongTheBatch) {
+  auto x = MakeParameter({8, 16});
+  auto softmax = make_shared<opset::Softmax>(x, 0);
+  EXPECT_FALSE(RowsAreIndependent({softmax}, {x}));
+
+  auto y = MakeParameter({8, 16});
+  auto cumsum = make_shared<opset::CumSum>(
+      y, opset::Constant::create(ov::element::i64, ov::Shape{}, {0}));
+  EXPECT_FALSE(RowsAreIndependent({cumsum}, {y}));
+}
+
+TEST(BatchAnalysis, RejectsMixedBatchDims) {
+  // x * transpose(x) has the batch in both dims
+  auto x = MakeParameter({8, 16});
+  auto gram = make_shared<opset::MatMul>(x, x, false, true);
+  EXPECT_FALSE(RowsAreIndependent({gram}, {x}));
+
+  // A concatenation along the batch doubles it
+  auto y = MakeParameter({8, 16});
+  auto concat = make_shared<opset::Concat>(ov::OutputVector{y, y}, 0);
+  EXPECT_FALSE(RowsAreIndependent({concat}, {y}));
+
+  // The batch has to be dim 0 of the results
+  auto z = MakeParameter({8, 16});
+  auto transpose = make_shared<opset::Transpose>(z, MakeAxes({1, 0}));
+  EXPECT_FALSE(RowsAreIndependent({transpose}, {z}));
+}
+
+TEST(BatchAnalysis, RejectsBatchSpecificShapes) {
+  // The constant target shape only fits a batch of 8
+  auto x = MakeParameter({8, 16});
+  auto reshape = make_shared<opset::Reshape>(x, MakeAxes({8, 4, 4}), false);
+  EXPECT_FALSE(RowsAreIndependent({reshape}, {x}));
+
+  auto y = MakeParameter({8, 16});
+  auto flat = make_shared<opset::Reshape>(y, MakeAxes({-1}), false);
+  EXPECT_FALSE(RowsAreIndependent({flat}, {y}));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
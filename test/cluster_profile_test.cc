@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/lib/io/path.h"
+
+#include "openvino_tensorflow/cluster_profile.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+class ClusterProfileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_path = io::JoinPath(::testing::TempDir(), "ovtf_cluster_profile.txt");
+    std::remove(m_path.c_str());
+    ClusterProfile::SetPath(m_path);
+  }
+  void TearDown() override {
+    ClusterProfile::SetPath("");
+    std::remove(m_path.c_str());
+  }
+
+  string m_path;
+};
+
+TEST_F(ClusterProfileTest, FingerprintIgnoresNodeOrder) {
+  EXPECT_EQ(ClusterProfile::Fingerprint({"a", "b", "c"}),
+            ClusterProfile::Fingerprint({"c", "a", "b"}));
+  EXPECT_NE(ClusterProfile::Fingerprint({"a", "b"}),
+            ClusterProfile::Fingerprint({"a", "b", "c"}));
+}
+
+TEST_F(ClusterProfileTest, RecordsAcrossProcesses) {
+  uint64 fingerprint = ClusterProfile::Fingerprint({"conv", "relu"});
+  ClusterProfile::RecordExecution(fingerprint, 100, 20);
+  ClusterProfile::RecordExecution(fingerprint, 300, 40);
+  ClusterProfile::RecordTF(fingerprint, 500);
+  ClusterProfile::RecordCompile(fingerprint, 1000);
+  ASSERT_EQ(ClusterProfile::Save(), Status::OK());
+
+  // A new process loads the totals and adds to them
+  ClusterProfile::SetPath(m_path);
+  ClusterProfile::RecordExecution(fingerprint, 200, 0);
+  ClusterProfile::Entry entry;
+  ASSERT_TRUE(ClusterProfile::Lookup(fingerprint, entry));
+  EXPECT_EQ(entry.calls, 3);
+  EXPECT_EQ(entry.execute_us, 600);
+  EXPECT_EQ(entry.boundary_us, 60);
+  EXPECT_EQ(entry.tf_calls, 1);
+  EXPECT_EQ(entry.tf_us, 500);
+  EXPECT_EQ(entry.compiles, 1);
+  EXPECT_EQ(entry.compile_us, 1000);
+
+  EXPECT_FALSE(ClusterProfile::Lookup(
+      ClusterProfile::Fingerprint({"conv"}), entry));
+}
+
+TEST_F(ClusterProfileTest, ComparesWithTF) {
+  ClusterProfile::Entry entry;
+  entry.calls = 100;
+  entry.execute_us = 100 * 50;
+  entry.boundary_us = 100 * 10;
+  entry.tf_calls = 2;
+  entry.tf_us = 2 * 40;
+  // Not enough TF measurements yet
+  EXPECT_FALSE(entry.SlowerThanTF());
+
+  entry.tf_calls = 4;
+  entry.tf_us = 4 * 40;
+  EXPECT_TRUE(entry.SlowerThanTF());
+  EXPECT_FALSE(entry.BoundaryDominated());
+
+  entry.tf_us = 4 * 100;
+  EXPECT_FALSE(entry.SlowerThanTF());
+  // The compilations are amortized over the calls
+  entry.compile_us = 100 * 50;
+  EXPECT_TRUE(entry.SlowerThanTF());
+
+  entry.boundary_us = 100 * 60;
+  EXPECT_TRUE(entry.BoundaryDominated());
+}
+
+TEST_F(ClusterProfileTest, DisabledWithoutPath) {
+  ClusterProfile::SetPath("");
+  EXPECT_FALSE(ClusterProfile::IsEnabled());
+  uint64 fingerprint = ClusterProfile::Fingerprint({"add"});
+  ClusterProfile::RecordExecution(fingerprint, 100, 0);
+  ClusterProfile::Entry entry;
+  EXPECT_FALSE(ClusterProfile::Lookup(fingerprint, entry));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/lib/core/errors.h"
+
+#include "openvino_tensorflow/compile_scheduler.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(CompileScheduler, DeduplicatesAndWaitsForJobs) {
+  auto& scheduler = CompileScheduler::Get();
+  int owner;
+  std::mutex mutex;
+  std::condition_variable released;
+  bool release = false;
+  std::atomic<int> runs{0};
+
+  auto blocking_job = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    released.wait(lock, [&]() { return release; });
+    runs++;
+    return Status::OK();
+  };
+  ASSERT_EQ(scheduler.Submit(&owner, "dedup", blocking_job),
+            CompileScheduler::SubmitResult::kQueued);
+  ASSERT_EQ(scheduler.Submit(&owner, "dedup", blocking_job),
+            CompileScheduler::SubmitResult::kInFlight);
+  ASSERT_TRUE(scheduler.IsInFlight("dedup"));
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  released.notify_all();
+  scheduler.Wait("dedup");
+  ASSERT_FALSE(scheduler.IsInFlight("dedup"));
+  ASSERT_EQ(runs.load(), 1);
+}
+
+TEST(CompileScheduler, CountsFailedJobs) {
+  auto& scheduler = CompileScheduler::Get();
+  int owner;
+  auto before = scheduler.GetProgress();
+
+  scheduler.Submit(&owner, "succeeds", []() { return Status::OK(); });
+  scheduler.Submit(&owner, "fails",
+                   []() { return errors::Internal("Compile error"); });
+  scheduler.Submit(&owner, "throws", []() -> Status {
+    throw std::runtime_error("Compile exception");
+  });
+  scheduler.Wait("succeeds");
+  scheduler.Wait("fails");
+  scheduler.Wait("throws");
+
+  auto after = scheduler.GetProgress();
+  ASSERT_EQ(after.completed, before.completed + 1);
+  ASSERT_EQ(after.failed, before.failed + 2);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
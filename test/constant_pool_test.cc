@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/constant_pool.h"
+#include "openvino_tensorflow/default_opset.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+static std::shared_ptr<opset::Constant> MakeConstant(
+    const vector<float>& values, const ov::Shape& shape) {
+  return std::dynamic_pointer_cast<opset::Constant>(ConstantPool::MakeConstant(
+      ov::element::f32, shape, values.data(), values.size() * sizeof(float)));
+}
+
+class ConstantPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ConstantPool::Clear(); }
+  void TearDown() override { ConstantPool::Clear(); }
+};
+
+TEST_F(ConstantPoolTest, SharesIdenticalData) {
+  if (!ConstantPool::IsEnabled()) return;
+  vector<float> values(1024, 1.5f);
+  auto a = MakeConstant(values, ov::Shape{1024});
+  auto b = MakeConstant(values, ov::Shape{1024});
+  ASSERT_NE(a, nullptr);
+  ASSERT_NE(b, nullptr);
+  ASSERT_NE(a, b);
+  EXPECT_EQ(a->get_data_ptr(), b->get_data_ptr());
+  EXPECT_EQ(b->cast_vector<float>(), values);
+
+  auto stats = ConstantPool::GetStats();
+  EXPECT_EQ(stats.num_buffers, 1);
+  EXPECT_EQ(stats.size_bytes, 4096);
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.shared_bytes, 4096);
+}
+
+TEST_F(ConstantPoolTest, SeparatesDifferentConstants) {
+  if (!ConstantPool::IsEnabled()) return;
+  vector<float> values(1024, 1.5f);
+  vector<float> other_values(values);
+  other_values.back() = 2.5f;
+  auto a = MakeConstant(values, ov::Shape{1024});
+  auto b = MakeConstant(other_values, ov::Shape{1024});
+  auto c = MakeConstant(values, ov::Shape{32, 32});
+  EXPECT_NE(a->get_data_ptr(), b->get_data_ptr());
+  EXPECT_NE(a->get_data_ptr(), c->get_data_ptr());
+  EXPECT_EQ(b->cast_vector<float>(), other_values);
+  EXPECT_EQ(ConstantPool::GetStats().num_buffers, 3);
+  EXPECT_EQ(ConstantPool::GetStats().hits, 0);
+}
+
+TEST_F(ConstantPoolTest, ReleasesUnusedBuffers) {
+  if (!ConstantPool::IsEnabled()) return;
+  vector<float> values(1024, 1.5f);
+  auto a = MakeConstant(values, ov::Shape{1024});
+  EXPECT_EQ(ConstantPool::GetStats().num_buffers, 1);
+  a.reset();
+  EXPECT_EQ(ConstantPool::GetStats().num_buffers, 0);
+}
+
+TEST_F(ConstantPoolTest, SkipsSmallAndMismatchedData) {
+  vector<float> values(4, 1.5f);
+  EXPECT_EQ(MakeConstant(values, ov::Shape{4}), nullptr);
+  vector<float> large_values(1024, 1.5f);
+  EXPECT_EQ(MakeConstant(large_values, ov::Shape{2048}), nullptr);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/executable_cache.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// The cache does not look into the executables, so the tests use signatures
+// of differently shaped inputs with null executables
+static InputSignature MakeSignature(int64 dim) {
+  Tensor x(DT_FLOAT, TensorShape({dim}));
+  InputSignature signature;
+  EXPECT_EQ(signature.Compute({x}, vector<bool>{false}), Status::OK());
+  return signature;
+}
+
+class ExecutableCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ExecutableCache::Clear();
+    ExecutableCache::SetLimit(0);
+  }
+  void TearDown() override {
+    ExecutableCache::Clear();
+    ExecutableCache::SetLimit(0);
+  }
+  int m_owner_a;
+  int m_owner_b;
+};
+
+TEST_F(ExecutableCacheTest, LookupAfterInsert) {
+  std::shared_ptr<Executable> exec;
+  ASSERT_FALSE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(1), nullptr, 100, 16);
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  // Entries are private to their owner
+  ASSERT_FALSE(ExecutableCache::Lookup(&m_owner_b, MakeSignature(1), exec));
+
+  auto stats = ExecutableCache::GetStats();
+  ASSERT_EQ(stats.num_entries, 1);
+  ASSERT_EQ(stats.size_bytes, 100);
+  ASSERT_EQ(stats.insertions, 1);
+}
+
+TEST_F(ExecutableCacheTest, OwnerDepthEvictsLeastRecentlyUsed) {
+  std::shared_ptr<Executable> exec;
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(1), nullptr, 10, 2);
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(2), nullptr, 10, 2);
+  ExecutableCache::Insert(&m_owner_b, MakeSignature(3), nullptr, 10, 2);
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(4), nullptr, 10, 2);
+
+  ASSERT_EQ(ExecutableCache::NumEntries(&m_owner_a), 2u);
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  ASSERT_FALSE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(2), exec));
+  // Other owners are not affected by the depth
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_b, MakeSignature(3), exec));
+}
+
+TEST_F(ExecutableCacheTest, ByteLimitEvictsAcrossOwners) {
+  std::shared_ptr<Executable> exec;
+  ExecutableCache::SetLimit(250);
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(1), nullptr, 100, 16);
+  ExecutableCache::Insert(&m_owner_b, MakeSignature(2), nullptr, 100, 16);
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  ExecutableCache::Insert(&m_owner_b, MakeSignature(3), nullptr, 100, 16);
+
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  ASSERT_FALSE(ExecutableCache::Lookup(&m_owner_b, MakeSignature(2), exec));
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_b, MakeSignature(3), exec));
+
+  auto stats = ExecutableCache::GetStats();
+  ASSERT_EQ(stats.num_entries, 2);
+  ASSERT_EQ(stats.size_bytes, 200);
+  ASSERT_EQ(stats.limit_bytes, 250);
+  ASSERT_EQ(stats.evictions, 1);
+  ASSERT_EQ(stats.evicted_bytes, 100);
+
+  // An entry larger than the limit replaces everything but stays cached
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(4), nullptr, 1000, 16);
+  ASSERT_EQ(ExecutableCache::GetStats().num_entries, 1);
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(4), exec));
+}
+
+TEST_F(ExecutableCacheTest, EvictOwner) {
+  std::shared_ptr<Executable> exec;
+  ExecutableCache::Insert(&m_owner_a, MakeSignature(1), nullptr, 100, 16);
+  ExecutableCache::Insert(&m_owner_b, MakeSignature(1), nullptr, 50, 16);
+  ExecutableCache::EvictOwner(&m_owner_a);
+
+  ASSERT_EQ(ExecutableCache::NumEntries(&m_owner_a), 0u);
+  ASSERT_FALSE(ExecutableCache::Lookup(&m_owner_a, MakeSignature(1), exec));
+  ASSERT_TRUE(ExecutableCache::Lookup(&m_owner_b, MakeSignature(1), exec));
+  ASSERT_EQ(ExecutableCache::GetStats().size_bytes, 50);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
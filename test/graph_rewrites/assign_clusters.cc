@@ -11,6 +11,7 @@
 #include "logging/tf_graph_writer.h"
 #include "openvino_tensorflow/assign_clusters.h"
 #include "openvino_tensorflow/ovtf_utils.h"
+#include "openvino_tensorflow/tf_deadness_analysis.h"
 #include "test/test_utilities.h"
 
 using namespace std;
@@ -143,6 +144,151 @@ TEST(AssignClusters, Cone) {
   ASSERT_EQ(node1_cluster, node2_cluster);
 }
 
+// Given a graph of this form:
+//
+//  Node1--->Node3
+//    \       ^
+//     v     /
+//     Node2
+//
+// Node1-->Node3 cannot be contracted while Node2 is in a cluster of its own,
+// so it has to be examined again after Node2 was merged.
+TEST(AssignClusters, Triangle) {
+  Graph g(OpRegistry::Global());
+
+  Node* node1;
+  ASSERT_OK(NodeBuilder("node1", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Finalize(&g, &node1));
+
+  Node* node2;
+  ASSERT_OK(NodeBuilder("node2", "Abs")
+                .Input(node1, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Finalize(&g, &node2));
+
+  Node* node3;
+  ASSERT_OK(NodeBuilder("node3", "Add")
+                .Input(node1, 0)
+                .Input(node2, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Finalize(&g, &node3));
+
+  Node* source = g.source_node();
+  Node* sink = g.sink_node();
+  g.AddEdge(source, Graph::kControlSlot, node1, Graph::kControlSlot);
+  g.AddEdge(node3, Graph::kControlSlot, sink, Graph::kControlSlot);
+
+  ASSERT_OK(AssignClusters(&g));
+
+  int node1_cluster, node2_cluster, node3_cluster;
+  ASSERT_OK(GetNodeCluster(node1, &node1_cluster));
+  ASSERT_OK(GetNodeCluster(node2, &node2_cluster));
+  ASSERT_OK(GetNodeCluster(node3, &node3_cluster));
+
+  ASSERT_EQ(node1_cluster, node2_cluster);
+  ASSERT_EQ(node2_cluster, node3_cluster);
+}
+
+// A long chain ends up in a single cluster
+TEST(AssignClusters, LongChain) {
+  Graph g(OpRegistry::Global());
+
+  Node* input;
+  ASSERT_OK(NodeBuilder("input", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Finalize(&g, &input));
+  g.AddEdge(g.source_node(), Graph::kControlSlot, input, Graph::kControlSlot);
+
+  std::vector<Node*> chain{input};
+  for (int i = 0; i < 1000; i++) {
+    Node* node;
+    ASSERT_OK(NodeBuilder("abs_" + to_string(i), "Abs")
+                  .Input(chain.back(), 0)
+                  .Attr("T", DT_FLOAT)
+                  .Attr("_ovtf_marked_for_clustering", true)
+                  .Finalize(&g, &node));
+    chain.push_back(node);
+  }
+  g.AddEdge(chain.back(), Graph::kControlSlot, g.sink_node(),
+            Graph::kControlSlot);
+
+  ASSERT_OK(AssignClusters(&g));
+
+  int first_cluster;
+  ASSERT_OK(GetNodeCluster(chain.front(), &first_cluster));
+  for (auto node : chain) {
+    int cluster;
+    ASSERT_OK(GetNodeCluster(node, &cluster));
+    ASSERT_EQ(cluster, first_cluster) << node->name();
+  }
+}
+
+// Nodes fed by the same Switch output share a predicate handle, which
+// differs from the one of the other output
+TEST(DeadnessAnalysis, InternsPredicates) {
+  Graph g(OpRegistry::Global());
+
+  Node* data;
+  ASSERT_OK(NodeBuilder("data", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&g, &data));
+  Node* pred;
+  ASSERT_OK(NodeBuilder("pred", "_Arg")
+                .Attr("T", DT_BOOL)
+                .Attr("index", 1)
+                .Finalize(&g, &pred));
+  Node* switch_node;
+  ASSERT_OK(NodeBuilder("switch", "Switch")
+                .Input(data, 0)
+                .Input(pred, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &switch_node));
+
+  std::vector<Node*> branch_nodes;
+  for (int output : {0, 1, 1}) {
+    Node* node;
+    ASSERT_OK(NodeBuilder("abs_" + to_string(branch_nodes.size()), "Abs")
+                  .Input(switch_node, output)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(&g, &node));
+    g.AddEdge(node, Graph::kControlSlot, g.sink_node(), Graph::kControlSlot);
+    branch_nodes.push_back(node);
+  }
+  g.AddEdge(g.source_node(), Graph::kControlSlot, data, Graph::kControlSlot);
+  g.AddEdge(g.source_node(), Graph::kControlSlot, pred, Graph::kControlSlot);
+
+  std::unique_ptr<DeadnessAnalysis> deadness;
+  ASSERT_OK(DeadnessAnalysis::Run(g, &deadness));
+
+  DeadnessAnalysis::PredicateHandle data_pred, false_pred, true_pred,
+      other_true_pred, switch_pred;
+  ASSERT_OK(deadness->GetNodePredicate(*data, data_pred));
+  ASSERT_OK(deadness->GetNodePredicate(*branch_nodes[0], false_pred));
+  ASSERT_OK(deadness->GetNodePredicate(*branch_nodes[1], true_pred));
+  ASSERT_OK(deadness->GetNodePredicate(*branch_nodes[2], other_true_pred));
+  ASSERT_OK(deadness->GetNodePredicate(*switch_node, switch_pred));
+
+  EXPECT_TRUE(deadness->IsTruePredicate(data_pred));
+  EXPECT_FALSE(deadness->IsTruePredicate(true_pred));
+  EXPECT_EQ(true_pred, other_true_pred);
+  EXPECT_NE(true_pred, false_pred);
+  EXPECT_TRUE(DeadnessAnalysis::IsControlFlowPredicate(switch_pred));
+
+  string true_pred_string;
+  ASSERT_OK(deadness->GetNodePredicate(*branch_nodes[1], true_pred_string));
+  EXPECT_EQ(true_pred_string, deadness->PredicateString(true_pred));
+  EXPECT_TRUE(DeadnessAnalysis::IsTruePredString(
+      deadness->PredicateString(data_pred)));
+}
+
 }  // namespace testing
 }  // namespace openvino_tensorflow
 }  // namespace tensorflow
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/cluster_cost_model.h"
+#include "openvino_tensorflow/graph_shapes.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+
+// An op without a shape function
+REGISTER_OP("OvtfTestNoShapeFn").Input("x: float").Output("y: float");
+
+namespace openvino_tensorflow {
+
+namespace testing {
+
+static Node* Placeholder(Graph* g, const string& name,
+                         const TensorShape& shape) {
+  Node* node;
+  EXPECT_EQ(NodeBuilder(name, "Placeholder")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("shape", shape)
+                .Finalize(g, &node),
+            Status::OK());
+  return node;
+}
+
+// A large matrix product pays for the call
+TEST(ClusterCostModel, KeepsComputeHeavyCluster) {
+  Graph g(OpRegistry::Global());
+  Node* a = Placeholder(&g, "a", TensorShape({512, 512}));
+  Node* b = Placeholder(&g, "b", TensorShape({512, 512}));
+  Node* matmul;
+  ASSERT_OK(NodeBuilder("matmul", "MatMul")
+                .Input(a, 0)
+                .Input(b, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &matmul));
+  Node* relu;
+  ASSERT_OK(NodeBuilder("relu", "Relu")
+                .Input(matmul, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &relu));
+
+  GraphShapes shapes(g);
+  ClusterCostModel model(&g, shapes, "CPU");
+  auto estimate = model.EstimateCluster({matmul, relu});
+  ASSERT_EQ(estimate.num_ops, 2);
+  ASSERT_EQ(estimate.flops, 2LL * 512 * 512 * 512 + 512 * 512);
+  // a and b, relu has no consumers
+  ASSERT_EQ(estimate.boundary_tensors, 2);
+  ASSERT_GT(estimate.Gain(), 0) << estimate.DebugString();
+}
+
+// A single op on a few elements does not
+TEST(ClusterCostModel, BustsTinyCluster) {
+  Graph g(OpRegistry::Global());
+  Node* x = Placeholder(&g, "x", TensorShape({4}));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(x, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &abs));
+  Node* neg;
+  ASSERT_OK(NodeBuilder("neg", "Neg")
+                .Input(abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &neg));
+
+  GraphShapes shapes(g);
+  ClusterCostModel model(&g, shapes, "CPU");
+  auto estimate = model.EstimateCluster({abs});
+  ASSERT_EQ(estimate.num_ops, 1);
+  ASSERT_EQ(estimate.boundary_tensors, 2);
+  ASSERT_EQ(estimate.boundary_bytes, 32);
+  ASSERT_LE(estimate.Gain(), 0) << estimate.DebugString();
+}
+
+// An op without a shape function does not stop the inference of its users
+TEST(GraphShapes, InfersPastOpsWithoutShapeFunctions) {
+  Graph g(OpRegistry::Global());
+  Node* x = Placeholder(&g, "x", TensorShape({4, 8}));
+  Node* opaque;
+  ASSERT_OK(NodeBuilder("opaque", "OvtfTestNoShapeFn")
+                .Input(x, 0)
+                .Finalize(&g, &opaque));
+  Tensor shape_value(DT_INT32, TensorShape({2}));
+  shape_value.vec<int32>()(0) = 2;
+  shape_value.vec<int32>()(1) = 16;
+  Node* shape;
+  ASSERT_OK(NodeBuilder("shape", "Const")
+                .Attr("dtype", DT_INT32)
+                .Attr("value", shape_value)
+                .Finalize(&g, &shape));
+  Node* reshape;
+  ASSERT_OK(NodeBuilder("reshape", "Reshape")
+                .Input(opaque, 0)
+                .Input(shape, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &reshape));
+
+  GraphShapes shapes(g);
+  ASSERT_TRUE(shapes.OutputShape(x->id(), 0)
+                  .IsIdenticalTo(PartialTensorShape({4, 8})));
+  ASSERT_TRUE(shapes.OutputShape(opaque->id(), 0).unknown_rank());
+  ASSERT_TRUE(shapes.OutputShape(reshape->id(), 0)
+                  .IsIdenticalTo(PartialTensorShape({2, 16})));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/node_builder.h"
+
+#include "openvino_tensorflow/assign_clusters.h"
+#include "openvino_tensorflow/cluster_manager.h"
+#include "openvino_tensorflow/deassign_clusters.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// Builds
+//
+//   const(0) ---> abs(0) ---> identity ---> add(1)
+//                   |                        ^
+//                   +-------> relu ----------+   (with_side_path)
+//
+// where identity and relu are not assigned a cluster
+static void BuildPassThroughGraph(Graph* g, bool with_side_path, Node** abs,
+                                  Node** identity, Node** add) {
+  int cluster_0 = NGraphClusterManager::NewCluster();
+  int cluster_1 = NGraphClusterManager::NewCluster();
+
+  Tensor t_input(DT_FLOAT, TensorShape{2, 3});
+  Node* input;
+  ASSERT_OK(NodeBuilder("input", "Const")
+                .Attr("dtype", DT_FLOAT)
+                .Attr("value", t_input)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_0)
+                .Finalize(g, &input));
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(input, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_0)
+                .Finalize(g, abs));
+  ASSERT_OK(NodeBuilder("identity", "Identity")
+                .Input(*abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(g, identity));
+
+  Node* second_input = *identity;
+  if (with_side_path) {
+    ASSERT_OK(NodeBuilder("relu", "Relu")
+                  .Input(*abs, 0)
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(g, &second_input));
+  }
+  ASSERT_OK(NodeBuilder("add", "Add")
+                .Input(*identity, 0)
+                .Input(second_input, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("_ovtf_marked_for_clustering", true)
+                .Attr("_ovtf_cluster", cluster_1)
+                .Finalize(g, add));
+
+  g->AddEdge(g->source_node(), Graph::kControlSlot, input,
+             Graph::kControlSlot);
+  g->AddEdge(*add, Graph::kControlSlot, g->sink_node(), Graph::kControlSlot);
+}
+
+class DeassignClustersTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    NGraphClusterManager::EvictAllClusters();
+    // Keep the small clusters of the tests
+    setenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES", "1", 1);
+  }
+  void TearDown() override {
+    unsetenv("OPENVINO_TF_MIN_NONTRIVIAL_NODES");
+    NGraphClusterManager::EvictAllClusters();
+  }
+};
+
+TEST_F(DeassignClustersTest, FusesClustersAroundIdentity) {
+  Graph g(OpRegistry::Global());
+  Node *abs, *identity, *add;
+  BuildPassThroughGraph(&g, false, &abs, &identity, &add);
+  ASSERT_OK(DeassignClusters(&g));
+
+  int abs_cluster, identity_cluster, add_cluster;
+  ASSERT_OK(GetNodeCluster(abs, &abs_cluster));
+  ASSERT_OK(GetNodeCluster(identity, &identity_cluster));
+  ASSERT_OK(GetNodeCluster(add, &add_cluster));
+  ASSERT_EQ(abs_cluster, identity_cluster);
+  ASSERT_EQ(abs_cluster, add_cluster);
+}
+
+TEST_F(DeassignClustersTest, KeepsClustersWithOtherPaths) {
+  Graph g(OpRegistry::Global());
+  Node *abs, *identity, *add;
+  BuildPassThroughGraph(&g, true, &abs, &identity, &add);
+  ASSERT_OK(DeassignClusters(&g));
+
+  // Merging would create a cycle through relu
+  int abs_cluster, identity_cluster, add_cluster;
+  ASSERT_OK(GetNodeCluster(abs, &abs_cluster));
+  ASSERT_NOT_OK(GetNodeCluster(identity, &identity_cluster));
+  ASSERT_OK(GetNodeCluster(add, &add_cluster));
+  ASSERT_NE(abs_cluster, add_cluster);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
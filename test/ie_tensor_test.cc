@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/ie_tensor.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(IETensorPool, ReusesWrappers) {
+  IETensorPool pool;
+  vector<float> data(12);
+  auto first = pool.Get(0, ov::element::f32, TensorShape({4, 3}), data.data());
+  ASSERT_EQ(first->data(), data.data());
+  ASSERT_EQ(first->get_shape(), (ov::Shape{4, 3}));
+  IETensor* first_ptr = first.get();
+  first.reset();
+
+  // The same buffer, type and shape get the same wrapper
+  auto second =
+      pool.Get(0, ov::element::f32, TensorShape({4, 3}), data.data());
+  ASSERT_EQ(second.get(), first_ptr);
+  second.reset();
+
+  // Anything else gets a new one
+  auto reshaped =
+      pool.Get(0, ov::element::f32, TensorShape({3, 4}), data.data());
+  ASSERT_EQ(reshaped->get_shape(), (ov::Shape{3, 4}));
+  IETensor* reshaped_ptr = reshaped.get();
+  reshaped.reset();
+  auto moved =
+      pool.Get(0, ov::element::f32, TensorShape({3, 4}), data.data() + 1);
+  ASSERT_NE(moved.get(), reshaped_ptr);
+  ASSERT_EQ(moved->data(), data.data() + 1);
+
+  // Slots are independent of each other
+  auto other = pool.Get(1, ov::element::f32, TensorShape({3, 4}),
+                        data.data() + 1);
+  ASSERT_NE(other.get(), moved.get());
+}
+
+TEST(IETensorPool, DoesNotReuseHeldWrappers) {
+  IETensorPool pool;
+  vector<float> data(12);
+  auto first = pool.Get(0, ov::element::f32, TensorShape({12}), data.data());
+  // An earlier call still holds the wrapper
+  auto second = pool.Get(0, ov::element::f32, TensorShape({12}), data.data());
+  ASSERT_NE(second.get(), first.get());
+  ASSERT_EQ(second->data(), data.data());
+
+  // The pool now tracks the second one, which is reused once released
+  IETensor* second_ptr = second.get();
+  second.reset();
+  auto third = pool.Get(0, ov::element::f32, TensorShape({12}), data.data());
+  ASSERT_EQ(third.get(), second_ptr);
+  ASSERT_NE(third.get(), first.get());
+}
+
+#if TF_MAJOR_VERSION >= 2
+TEST(IETensorBuffer, AliasesOpenVINOMemory) {
+  auto ng_tensor =
+      make_shared<IETensor>(ov::element::f32, ov::Shape{4, 3});
+  float* ng_data = ng_tensor->data<float>();
+  for (int i = 0; i < 12; i++) ng_data[i] = i;
+  ASSERT_TRUE(IETensorBuffer::CanAlias(*ng_tensor, DT_FLOAT));
+
+  auto buffer = new IETensorBuffer(ng_tensor);
+  Tensor tf_tensor(DT_FLOAT, TensorShape({4, 3}), buffer);
+  buffer->Unref();
+  ASSERT_EQ(tf_tensor.flat<float>().data(), ng_data);
+  ASSERT_EQ(tf_tensor.matrix<float>()(2, 1), 7.0f);
+
+  // The TF tensor keeps the OpenVINO tensor alive
+  weak_ptr<IETensor> weak_ng_tensor = ng_tensor;
+  ng_tensor.reset();
+  ASSERT_FALSE(weak_ng_tensor.expired());
+  Tensor rows = tf_tensor.Slice(0, 2);
+  tf_tensor = Tensor();
+  ASSERT_FALSE(weak_ng_tensor.expired());
+  ASSERT_EQ(rows.matrix<float>()(1, 2), 5.0f);
+  rows = Tensor();
+  ASSERT_TRUE(weak_ng_tensor.expired());
+}
+
+TEST(IETensorBuffer, RejectsMisalignedMemory) {
+  vector<float> storage(16 + EIGEN_MAX_ALIGN_BYTES);
+  char* base = reinterpret_cast<char*>(storage.data());
+  while (reinterpret_cast<uintptr_t>(base) % EIGEN_MAX_ALIGN_BYTES != 0) {
+    base++;
+  }
+  IETensor aligned(ov::element::f32, ov::Shape{4}, base);
+  IETensor misaligned(ov::element::f32, ov::Shape{4}, base + sizeof(float));
+  ASSERT_TRUE(IETensorBuffer::CanAlias(aligned, DT_FLOAT));
+  ASSERT_FALSE(IETensorBuffer::CanAlias(misaligned, DT_FLOAT));
+  ASSERT_FALSE(IETensorBuffer::CanAlias(aligned, DT_STRING));
+}
+
+TEST(IETensorBuffer, HandsOffAliasedTensors) {
+  auto ng_tensor =
+      make_shared<IETensor>(ov::element::f32, ov::Shape{4, 3});
+  auto buffer = new IETensorBuffer(ng_tensor);
+  Tensor tf_tensor(DT_FLOAT, TensorShape({4, 3}), buffer);
+  buffer->Unref();
+
+  ASSERT_EQ(IETensorBuffer::GetAliasedTensor(tf_tensor, ov::element::f32),
+            ng_tensor);
+  // Partial views and other types need a wrapper of their own
+  ASSERT_EQ(IETensorBuffer::GetAliasedTensor(tf_tensor.Slice(0, 2),
+                                             ov::element::f32),
+            nullptr);
+  ASSERT_EQ(IETensorBuffer::GetAliasedTensor(tf_tensor, ov::element::i32),
+            nullptr);
+  Tensor tf_owned(DT_FLOAT, TensorShape({4, 3}));
+  ASSERT_EQ(IETensorBuffer::GetAliasedTensor(tf_owned, ov::element::f32),
+            nullptr);
+}
+#endif
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+
+#include "openvino_tensorflow/input_signature.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+TEST(InputSignature, SameInputsMatch) {
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor shape(DT_INT32, TensorShape({2}));
+  AssignInputValuesRandom<float>(x, -10.0f, 10.0f);
+  AssignInputValues<int32>(shape, vector<int32>{3, 2});
+  vector<Tensor> inputs{x, shape};
+  vector<bool> is_static{false, true};
+
+  InputSignature a, b;
+  ASSERT_OK(a.Compute(inputs, is_static));
+  ASSERT_OK(b.Compute(inputs, is_static));
+  ASSERT_TRUE(a.IsValid());
+  ASSERT_EQ(a, b);
+  ASSERT_EQ(a.Hash(), b.Hash());
+  ASSERT_TRUE(a.Matches(inputs, is_static));
+
+  // Non static contents do not affect the signature
+  AssignInputValuesRandom<float>(inputs[0], -10.0f, 10.0f);
+  ASSERT_TRUE(a.Matches(inputs, is_static));
+}
+
+TEST(InputSignature, ShapeAndStaticValuesDiffer) {
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor shape(DT_INT32, TensorShape({2}));
+  AssignInputValues<int32>(shape, vector<int32>{3, 2});
+  vector<bool> is_static{false, true};
+
+  InputSignature base;
+  ASSERT_OK(base.Compute({x, shape}, is_static));
+
+  Tensor y(DT_FLOAT, TensorShape({3, 2}));
+  InputSignature other_shape;
+  ASSERT_OK(other_shape.Compute({y, shape}, is_static));
+  ASSERT_NE(base, other_shape);
+  ASSERT_FALSE(base.Matches({y, shape}, is_static));
+
+  Tensor other(DT_INT32, TensorShape({2}));
+  AssignInputValues<int32>(other, vector<int32>{6, 1});
+  InputSignature other_value;
+  ASSERT_OK(other_value.Compute({x, other}, is_static));
+  ASSERT_NE(base, other_value);
+  ASSERT_FALSE(base.Matches({x, other}, is_static));
+
+  // The rank is part of the encoding, so flattened dims do not alias
+  Tensor flat(DT_FLOAT, TensorShape({6}));
+  Tensor scalar(DT_FLOAT, TensorShape({}));
+  InputSignature one_input, two_inputs;
+  ASSERT_OK(one_input.Compute({flat}, {false}));
+  ASSERT_OK(two_inputs.Compute({scalar, scalar}, {false, false}));
+  ASSERT_NE(one_input, two_inputs);
+}
+
+TEST(InputSignature, DynamicInputsOnlyEncodeRank) {
+  Tensor x(DT_FLOAT, TensorShape({2, 3}));
+  Tensor y(DT_FLOAT, TensorShape({5, 7}));
+  vector<bool> is_static{false};
+  vector<bool> is_dynamic{true};
+
+  InputSignature dynamic_x, dynamic_y, static_x;
+  ASSERT_OK(dynamic_x.Compute({x}, is_static, is_dynamic));
+  ASSERT_OK(dynamic_y.Compute({y}, is_static, is_dynamic));
+  ASSERT_OK(static_x.Compute({x}, is_static));
+  ASSERT_EQ(dynamic_x, dynamic_y);
+  ASSERT_TRUE(dynamic_x.Matches({y}, is_static, is_dynamic));
+  ASSERT_NE(dynamic_x, static_x);
+  ASSERT_FALSE(dynamic_x.Matches({x}, is_static));
+
+  Tensor z(DT_FLOAT, TensorShape({2, 3, 4}));
+  ASSERT_FALSE(dynamic_x.Matches({z}, is_static, is_dynamic));
+}
+
+TEST(InputSignature, UnsupportedStaticType) {
+  Tensor s(DT_STRING, TensorShape({1}));
+  InputSignature signature;
+  ASSERT_NOT_OK(signature.Compute({s}, {true}));
+  ASSERT_FALSE(signature.IsValid());
+  ASSERT_FALSE(signature.Matches({s}, {true}));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "openvino_tensorflow/micro_batcher.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+// Records the batches the batcher runs
+class BatchRecorder {
+ public:
+  MicroBatcher::RunFn RunFn() {
+    return [this](const string& key, vector<MicroBatcher::Request> requests) {
+      lock_guard<mutex> lock(m_mutex);
+      m_batches.emplace_back(key, std::move(requests));
+      m_batch_run.notify_all();
+    };
+  }
+
+  // Waits for up to timeout until num_batches batches have run
+  bool WaitFor(size_t num_batches, std::chrono::milliseconds timeout) {
+    unique_lock<mutex> lock(m_mutex);
+    return m_batch_run.wait_for(lock, timeout, [&]() {
+      return m_batches.size() >= num_batches;
+    });
+  }
+
+  vector<pair<string, vector<MicroBatcher::Request>>> Batches() {
+    lock_guard<mutex> lock(m_mutex);
+    return m_batches;
+  }
+
+ private:
+  mutex m_mutex;
+  condition_variable m_batch_run;
+  vector<pair<string, vector<MicroBatcher::Request>>> m_batches;
+};
+
+TEST(MicroBatcher, RunsAloneAfterTheWindow) {
+  BatchRecorder recorder;
+  MicroBatcher batcher(std::chrono::milliseconds(100), 8, recorder.RunFn());
+  auto start = std::chrono::steady_clock::now();
+  // The call does not wait for the window
+  batcher.Add("key", {nullptr, nullptr, 2});
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(100));
+  EXPECT_TRUE(recorder.Batches().empty());
+
+  ASSERT_TRUE(recorder.WaitFor(1, std::chrono::seconds(5)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(100));
+  auto batches = recorder.Batches();
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].first, "key");
+  ASSERT_EQ(batches[0].second.size(), 1);
+  EXPECT_EQ(batches[0].second[0].rows, 2);
+}
+
+TEST(MicroBatcher, RunsFullBatchesRightAway) {
+  BatchRecorder recorder;
+  MicroBatcher batcher(std::chrono::seconds(60), 4, recorder.RunFn());
+  batcher.Add("key", {nullptr, nullptr, 4});
+  // Run by the call itself
+  auto batches = recorder.Batches();
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].second.size(), 1);
+}
+
+TEST(MicroBatcher, CoalescesConcurrentRequests) {
+  // The batch fills up long before the window expires
+  BatchRecorder recorder;
+  MicroBatcher batcher(std::chrono::seconds(60), 4, recorder.RunFn());
+  batcher.Add("key", {nullptr, nullptr, 1});
+  // Requests of another key do not join the batch
+  batcher.Add("other", {nullptr, nullptr, 4});
+  batcher.Add("key", {nullptr, nullptr, 1});
+  auto batches = recorder.Batches();
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].first, "other");
+
+  std::thread filler([&]() { batcher.Add("key", {nullptr, nullptr, 2}); });
+  filler.join();
+  batches = recorder.Batches();
+  ASSERT_EQ(batches.size(), 2);
+  EXPECT_EQ(batches[1].first, "key");
+  ASSERT_EQ(batches[1].second.size(), 3);
+  EXPECT_EQ(batches[1].second[0].rows, 1);
+  EXPECT_EQ(batches[1].second[1].rows, 1);
+  EXPECT_EQ(batches[1].second[2].rows, 2);
+}
+
+TEST(MicroBatcher, OverflowingRequestStartsNextBatch) {
+  BatchRecorder recorder;
+  MicroBatcher batcher(std::chrono::milliseconds(200), 4, recorder.RunFn());
+  batcher.Add("key", {nullptr, nullptr, 3});
+  // Does not fit, runs the open batch and waits out its own window
+  batcher.Add("key", {nullptr, nullptr, 2});
+  auto batches = recorder.Batches();
+  ASSERT_EQ(batches.size(), 1);
+  ASSERT_EQ(batches[0].second.size(), 1);
+  EXPECT_EQ(batches[0].second[0].rows, 3);
+
+  ASSERT_TRUE(recorder.WaitFor(2, std::chrono::seconds(5)));
+  batches = recorder.Batches();
+  ASSERT_EQ(batches[1].second.size(), 1);
+  EXPECT_EQ(batches[1].second[0].rows, 2);
+}
+
+TEST(MicroBatcher, RunsOpenBatchesOnDestruction) {
+  BatchRecorder recorder;
+  {
+    MicroBatcher batcher(std::chrono::seconds(60), 8, recorder.RunFn());
+    batcher.Add("key", {nullptr, nullptr, 1});
+    batcher.Add("key", {nullptr, nullptr, 1});
+  }
+  auto batches = recorder.Batches();
+  ASSERT_EQ(batches.size(), 1);
+  EXPECT_EQ(batches[0].second.size(), 2);
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (C) 2021-2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *******************************************************************************/
+#include <utime.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+
+#include "openvino_tensorflow/model_cache.h"
+#include "test/test_utilities.h"
+
+using namespace std;
+
+namespace tensorflow {
+namespace openvino_tensorflow {
+namespace testing {
+
+class ModelCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_dir = io::JoinPath(::testing::TempDir(), "ovtf_model_cache_test");
+    RemoveDir();
+    ModelCache::SetCacheDir(m_dir);
+  }
+  void TearDown() override {
+    ModelCache::SetCacheDir("");
+    RemoveDir();
+  }
+
+  void RemoveDir() {
+    int64 undeleted_files, undeleted_dirs;
+    Env::Default()
+        ->DeleteRecursively(m_dir, &undeleted_files, &undeleted_dirs)
+        .IgnoreError();
+  }
+
+  vector<string> Children() {
+    vector<string> children;
+    Env::Default()->GetChildren(m_dir, &children).IgnoreError();
+    return children;
+  }
+
+  // Writes an entry of size bytes and sets its modification time
+  void WriteEntry(const string& key, size_t size, time_t mtime) {
+    ASSERT_OK(ModelCache::WriteEntry(m_dir, key, string(size, 'x')));
+    struct utimbuf times = {mtime, mtime};
+    ASSERT_EQ(utime(ModelCache::EntryPath(m_dir, key).c_str(), &times), 0);
+  }
+
+  string m_dir;
+};
+
+static InputSignature MakeSignature(int64 batch) {
+  InputSignature signature;
+  std::vector<Tensor> inputs = {Tensor(DT_FLOAT, TensorShape({batch, 4}))};
+  EXPECT_EQ(signature.Compute(inputs, {false}), Status::OK());
+  return signature;
+}
+
+static void BuildGraph(Graph& g) {
+  Node* arg;
+  ASSERT_OK(NodeBuilder("arg", "_Arg")
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&g, &arg));
+  Node* abs;
+  ASSERT_OK(NodeBuilder("abs", "Abs")
+                .Input(arg, 0)
+                .Attr("T", DT_FLOAT)
+                .Finalize(&g, &abs));
+  Node* ret;
+  ASSERT_OK(NodeBuilder("ret", "_Retval")
+                .Input(abs, 0)
+                .Attr("T", DT_FLOAT)
+                .Attr("index", 0)
+                .Finalize(&g, &ret));
+}
+
+TEST_F(ModelCacheTest, KeysAreStable) {
+  Graph g1(OpRegistry::Global());
+  BuildGraph(g1);
+  Graph g2(OpRegistry::Global());
+  BuildGraph(g2);
+  uint64 fingerprint = ModelCache::GraphFingerprint(g1);
+  ASSERT_EQ(fingerprint, ModelCache::GraphFingerprint(g2));
+
+  auto key = ModelCache::MakeKey(fingerprint, MakeSignature(1), "CPU");
+  EXPECT_EQ(key.size(), 32u);
+  EXPECT_EQ(key, ModelCache::MakeKey(fingerprint, MakeSignature(1), "CPU"));
+  EXPECT_NE(key, ModelCache::MakeKey(fingerprint, MakeSignature(2), "CPU"));
+  EXPECT_NE(key, ModelCache::MakeKey(fingerprint, MakeSignature(1), "GPU"));
+  EXPECT_NE(key,
+            ModelCache::MakeKey(fingerprint + 1, MakeSignature(1), "CPU"));
+}
+
+TEST_F(ModelCacheTest, WritesEntriesThroughATemporaryFile) {
+  ASSERT_OK(ModelCache::WriteEntry(m_dir, "key", "first"));
+  ASSERT_OK(ModelCache::WriteEntry(m_dir, "key", "second"));
+  string contents;
+  ASSERT_OK(ReadFileToString(Env::Default(),
+                             ModelCache::EntryPath(m_dir, "key"), &contents));
+  EXPECT_EQ(contents, "second");
+  // Only the renamed entry is left
+  EXPECT_EQ(Children(), vector<string>{"key.ovtfcache"});
+
+  // A failed write leaves nothing behind
+  string file_dir = io::JoinPath(m_dir, "key.ovtfcache");
+  EXPECT_FALSE(ModelCache::WriteEntry(file_dir, "key", "third").ok());
+  EXPECT_EQ(Children(), vector<string>{"key.ovtfcache"});
+}
+
+TEST_F(ModelCacheTest, RejectsBadMagicHeader) {
+  int64 misses = ModelCache::NumMisses();
+  ASSERT_OK(ModelCache::WriteEntry(m_dir, "key", "NOT_A_MODEL_CACHE 1\n0\n"));
+  EXPECT_EQ(ModelCache::Load("key"), nullptr);
+  EXPECT_EQ(ModelCache::NumMisses(), misses + 1);
+  // The entry is dropped so that the next store rewrites it
+  EXPECT_TRUE(Children().empty());
+  EXPECT_EQ(ModelCache::Load("key"), nullptr);
+  EXPECT_EQ(ModelCache::NumMisses(), misses + 2);
+}
+
+TEST_F(ModelCacheTest, EvictsOldestEntriesBeyondSizeLimit) {
+  WriteEntry("old", 1000, 1000);
+  WriteEntry("mid", 1000, 2000);
+  WriteEntry("new", 1000, 3000);
+  ASSERT_OK(WriteStringToFile(Env::Default(), io::JoinPath(m_dir, "notes"),
+                              string(5000, 'x')));
+
+  ModelCache::EnforceSizeLimit(m_dir, 3000);
+  EXPECT_EQ(Children().size(), 4u);
+
+  ModelCache::EnforceSizeLimit(m_dir, 2500);
+  auto children = Children();
+  std::sort(children.begin(), children.end());
+  EXPECT_EQ(children,
+            (vector<string>{"mid.ovtfcache", "new.ovtfcache", "notes"}));
+
+  // The newest entry is kept even if it exceeds the limit
+  ModelCache::EnforceSizeLimit(m_dir, 1);
+  children = Children();
+  std::sort(children.begin(), children.end());
+  EXPECT_EQ(children, (vector<string>{"new.ovtfcache", "notes"}));
+}
+
+}  // namespace testing
+}  // namespace openvino_tensorflow
+}  // namespace tensorflow
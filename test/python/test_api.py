@@ -55,3 +55,62 @@ class TestNgraphAPI(NgraphTest):
         openvino_tensorflow.stop_logging_placement()
         if not openvino_tensorflow.is_logging_placement() == 0:
             raise AssertionError
+
+    def test_warmup(self):
+        import numpy as np
+        import tensorflow as tf
+        tf.compat.v1.disable_eager_execution()
+
+        x = tf.compat.v1.placeholder(tf.float32, shape=(None, 8), name="x")
+        out = tf.nn.relu(tf.matmul(x, np.ones((8, 4), dtype=np.float32)))
+        test_input = np.random.rand(3, 8)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={x: test_input})
+
+        # Creating the callable rewrites the graph and creates its kernels,
+        # the compilations are done before the first run
+        def run_warm_test(sess):
+            run = sess.make_callable(out, [x])
+            if not openvino_tensorflow.wait_for_warmup(60000):
+                raise AssertionError
+            if not openvino_tensorflow.is_warmup_complete():
+                raise AssertionError
+            return run(test_input)
+
+        openvino_tensorflow.warmup({"x:0": [[3, 8], [5, 8]]})
+        try:
+            # Nothing was rewritten yet, so there is nothing to wait for
+            if openvino_tensorflow.wait_for_warmup():
+                raise AssertionError
+            if not np.allclose(
+                    self.without_ngraph(run_test),
+                    self.with_ngraph(run_warm_test)):
+                raise AssertionError
+        finally:
+            openvino_tensorflow.warmup({})
+
+    def test_set_compile_property(self):
+        import numpy as np
+        import tensorflow as tf
+        tf.compat.v1.disable_eager_execution()
+
+        x = tf.compat.v1.placeholder(tf.float32, shape=(2, 8), name="x")
+        out = tf.nn.relu(tf.matmul(x, np.ones((8, 4), dtype=np.float32)))
+        test_input = np.random.rand(2, 8)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={x: test_input})
+
+        with pytest.raises(ValueError):
+            openvino_tensorflow.set_compile_property("unknown_property", "1")
+        openvino_tensorflow.set_compile_property("performance_mode",
+                                                 "THROUGHPUT")
+        openvino_tensorflow.set_compile_property("enable_cpu_pinning", True)
+        try:
+            if not np.allclose(
+                    self.without_ngraph(run_test), self.with_ngraph(run_test)):
+                raise AssertionError
+        finally:
+            openvino_tensorflow.set_compile_property("performance_mode", "")
+            openvino_tensorflow.set_compile_property("enable_cpu_pinning", "")
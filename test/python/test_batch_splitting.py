@@ -0,0 +1,78 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow test for batches split across concurrent requests
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import pytest
+import time
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+import numpy as np
+
+import openvino_tensorflow
+from common import NgraphTest
+
+
+class TestBatchSplitting(NgraphTest):
+
+    def setup_method(self):
+        os.environ['OPENVINO_TF_ENABLE_BATCHING'] = '1'
+
+    def teardown_method(self):
+        os.environ.pop('OPENVINO_TF_ENABLE_BATCHING', None)
+
+    # Batch sizes that are not a multiple of the number of requests leave a
+    # smaller last slice
+    @pytest.mark.parametrize("batch", [2, 7, 33])
+    def test_split_batch(self, batch):
+        val = tf.compat.v1.placeholder(tf.float32, shape=(batch, 16))
+        weights = np.random.rand(16, 8).astype(np.float32)
+        out = tf.nn.relu(tf.matmul(val, weights))
+        test_input = np.random.rand(batch, 16)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={val: test_input})
+
+        # The models of the slices are compiled in the background, the calls
+        # run whole meanwhile
+        def run_until_split(sess):
+            stats = openvino_tensorflow.get_execution_stats()
+            for _ in range(50):
+                result = run_test(sess)
+                if openvino_tensorflow.get_execution_stats(
+                )['split_inferences'] > stats['split_inferences']:
+                    return result
+                time.sleep(0.1)
+            raise AssertionError
+
+        result = self.with_ngraph(run_until_split)
+        if not np.allclose(self.without_ngraph(run_test), result, 1e-5, 1e-6):
+            raise AssertionError
+
+    # The sum over the batch does not scale with it, so the cluster runs
+    # whole
+    def test_unsplittable_batch(self):
+        val = tf.compat.v1.placeholder(tf.float32, shape=(8, 16))
+        out = tf.reduce_sum(tf.nn.relu(val), axis=0)
+        test_input = np.random.rand(8, 16)
+
+        def run_test(sess):
+            return sess.run(out, feed_dict={val: test_input})
+
+        stats = openvino_tensorflow.get_execution_stats()
+        result = self.with_ngraph(run_test)
+        if openvino_tensorflow.get_execution_stats(
+        )['split_inferences'] != stats['split_inferences']:
+            raise AssertionError
+
+        if not np.allclose(self.without_ngraph(run_test), result, 1e-5, 1e-6):
+            raise AssertionError
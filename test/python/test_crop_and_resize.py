@@ -66,3 +66,41 @@ class TestCropAndResize(NgraphTest):
                 self.without_ngraph(run_test), self.with_ngraph(run_test), 1e-5,
                 1e-6):
             raise AssertionError
+
+    def test_crop_and_resize_runtime_boxes(self):
+
+        BATCH_SIZE = 3
+        IMAGE_HEIGHT = 32
+        IMAGE_WIDTH = 48
+        CHANNELS = 3
+        CROP_SIZE = (16, 8)
+
+        image = np.random.normal(
+            size=(BATCH_SIZE, IMAGE_HEIGHT, IMAGE_WIDTH, CHANNELS))
+        boxes = tf.compat.v1.placeholder(tf.float32, shape=(None, 4))
+        box_indices = tf.compat.v1.placeholder(tf.int32, shape=(None,))
+        output = tf.image.crop_and_resize(
+            image,
+            boxes,
+            box_indices,
+            CROP_SIZE,
+            method="bilinear",
+            extrapolation_value=-1.0)
+
+        # Flipped boxes and boxes reaching outside of the image included
+        feeds = [({
+            boxes: np.random.uniform(size=(5, 4)),
+            box_indices: np.random.randint(BATCH_SIZE, size=(5,))
+        }), ({
+            boxes: [[0.9, 0.8, 0.1, 0.2], [-0.5, -0.25, 1.5, 1.25]],
+            box_indices: [2, 0]
+        })]
+        for feed_dict in feeds:
+
+            def run_test(sess):
+                return sess.run((output,), feed_dict=feed_dict)
+
+            if not np.allclose(
+                    self.without_ngraph(run_test), self.with_ngraph(run_test),
+                    1e-5, 1e-6):
+                raise AssertionError
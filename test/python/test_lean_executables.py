@@ -0,0 +1,57 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow test for executables that only keep the compiled model
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import pytest
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+import numpy as np
+
+import openvino_tensorflow
+from common import NgraphTest
+
+
+class TestLeanExecutables(NgraphTest):
+
+    def setup_method(self):
+        os.environ['OPENVINO_TF_LEAN_EXECUTABLES'] = '1'
+
+    def teardown_method(self):
+        os.environ.pop('OPENVINO_TF_LEAN_EXECUTABLES', None)
+
+    # Every new batch size translates the released cluster graph again
+    def test_new_shapes_after_release(self):
+        val = tf.compat.v1.placeholder(tf.float32, shape=(None, 6))
+        weights = np.random.rand(6, 3).astype(np.float32)
+        out = tf.nn.relu(tf.matmul(val, weights)) + 1.0
+
+        test_inputs = [np.random.rand(batch, 6) for batch in [2, 5, 2, 7]]
+
+        # The executables and the released graph only live as long as the
+        # session
+        def run_test(sess):
+            return [
+                sess.run(out, feed_dict={val: test_input})
+                for test_input in test_inputs
+            ]
+
+        stats = openvino_tensorflow.get_execution_stats()
+        results = self.with_ngraph(run_test)
+        # One lean executable for each of the three batch sizes
+        if not openvino_tensorflow.get_execution_stats(
+        )['lean_executables'] >= stats['lean_executables'] + 3:
+            raise AssertionError
+
+        for expected, result in zip(self.without_ngraph(run_test), results):
+            if not np.allclose(expected, result, 1e-5, 1e-6):
+                raise AssertionError
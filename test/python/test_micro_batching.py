@@ -0,0 +1,69 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow test for concurrent calls coalesced into micro-batches
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import threading
+import pytest
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+import numpy as np
+
+import openvino_tensorflow
+from common import NgraphTest
+
+
+class TestMicroBatching(NgraphTest):
+
+    def setup_method(self):
+        os.environ['OPENVINO_TF_MICRO_BATCH_WINDOW_US'] = '100000'
+        os.environ['OPENVINO_TF_MICRO_BATCH_SIZE'] = '8'
+
+    def teardown_method(self):
+        os.environ.pop('OPENVINO_TF_MICRO_BATCH_WINDOW_US', None)
+        os.environ.pop('OPENVINO_TF_MICRO_BATCH_SIZE', None)
+
+    def test_concurrent_calls(self):
+        val = tf.compat.v1.placeholder(tf.float32, shape=(None, 16))
+        weights = np.random.rand(16, 8).astype(np.float32)
+        out = tf.nn.relu(tf.matmul(val, weights))
+        # Calls of one and two rows, each gets its own rows back
+        test_inputs = [np.random.rand(1 + i % 2, 16) for i in range(6)]
+
+        def run_test(sess):
+            results = [None] * len(test_inputs)
+            barrier = threading.Barrier(len(test_inputs))
+
+            def run(i):
+                barrier.wait()
+                results[i] = sess.run(out, feed_dict={val: test_inputs[i]})
+
+            threads = [
+                threading.Thread(target=run, args=(i,))
+                for i in range(len(test_inputs))
+            ]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+            return results
+
+        stats = openvino_tensorflow.get_execution_stats()
+        results = self.with_ngraph(run_test)
+        # The calls start together, well within the window of the first one
+        if not openvino_tensorflow.get_execution_stats(
+        )['micro_batches'] > stats['micro_batches']:
+            raise AssertionError
+
+        for expected, result in zip(self.without_ngraph(run_test), results):
+            if not np.allclose(expected, result, 1e-5, 1e-6):
+                raise AssertionError
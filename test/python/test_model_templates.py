@@ -0,0 +1,60 @@
+# ==============================================================================
+# Copyright (C) 2021-2022 Intel Corporation
+
+# SPDX-License-Identifier: Apache-2.0
+# ==============================================================================
+"""Openvino Tensorflow test for clusters reshaped to new input shapes
+
+"""
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import os
+import pytest
+
+import tensorflow as tf
+tf.compat.v1.disable_eager_execution()
+import numpy as np
+
+import openvino_tensorflow
+from common import NgraphTest
+
+
+class TestModelTemplates(NgraphTest):
+
+    def setup_method(self):
+        os.environ['OPENVINO_TF_MODEL_TEMPLATES'] = '1'
+
+    def teardown_method(self):
+        os.environ.pop('OPENVINO_TF_MODEL_TEMPLATES', None)
+
+    def test_reshape_to_new_batch_sizes(self):
+        val = tf.compat.v1.placeholder(tf.float32, shape=(None, 4, 6))
+        weights = np.random.rand(6, 3).astype(np.float32)
+
+        # The target shape of the reshape depends on the input shape, so the
+        # reshaped copies have to recompute it for every batch size
+        flat = tf.reshape(val, [tf.shape(val)[0] * 4, 6])
+        out = tf.reshape(
+            tf.nn.relu(tf.matmul(flat, weights)), [tf.shape(val)[0], -1])
+        test_inputs = [np.random.rand(batch, 4, 6) for batch in [2, 5, 3, 5]]
+
+        # The kernel and its templates only live as long as the session
+        def run_test(sess):
+            return [
+                sess.run(out, feed_dict={val: test_input})
+                for test_input in test_inputs
+            ]
+
+        stats = openvino_tensorflow.get_execution_stats()
+        results = self.with_ngraph(run_test)
+        # The new batch sizes after the first one are reshaped from its
+        # translation
+        if not openvino_tensorflow.get_execution_stats(
+        )['template_reshapes'] > stats['template_reshapes']:
+            raise AssertionError
+
+        for expected, result in zip(self.without_ngraph(run_test), results):
+            if not np.allclose(expected, result, 1e-5, 1e-6):
+                raise AssertionError